@@ -2,89 +2,189 @@
 
 #include "AfterImageFxManager.h"
 
+#include <cmath>
+
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
-#include "util/AxUtil.h"
 
 using namespace std;
 USING_NS_AX;
 
 namespace requiem {
 
-namespace {
-
-void createAfterImage(const Sprite* sprite,
-                      const int zOrder,
-                      const Color3B& color,
-                      const float durationInSec) {
-  Sprite* afterImage = Sprite::createWithSpriteFrame(sprite->getSpriteFrame());
-  afterImage->setPosition(sprite->getPosition());
-  afterImage->setScale(sprite->getScale());
-  afterImage->setRotation(sprite->getRotation());
-  afterImage->setVisible(sprite->isVisible());
-  afterImage->setLocalZOrder(sprite->getLocalZOrder());
-  afterImage->setFlippedX(sprite->isFlippedX());
-  afterImage->setColor(color);
-  afterImage->setOpacity(80);
-
-  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
-  ax_util::addChildWithParentCameraMask(gmMgr->getLayer(), afterImage, zOrder);
-
-  DelayTime* delay = DelayTime::create(durationInSec);
-  CallFunc* remove = CallFunc::create([=]() {
-    afterImage->removeFromParentAndCleanup(true);
-  });
-
-  afterImage->runAction(Sequence::create(delay, remove, nullptr));
+AfterImageFxManager::~AfterImageFxManager() {
+  for (auto& [_, afterImageFxData] : _entries) {
+    releaseAfterImages(afterImageFxData);
+  }
 }
 
-void createAfterImage(const Node* node, const Color3B& color, const float durationInSec) {
-  for (const auto child : node->getChildren()) {
-    if (const auto spriteBatchNode = dynamic_cast<SpriteBatchNode*>(child)) {
-      for (const Sprite* sprite : spriteBatchNode->getDescendants()) {
-        createAfterImage(sprite, child->getLocalZOrder() - 1, color, durationInSec);
+void AfterImageFxManager::update(const float delta) {
+  for (auto it = _entries.begin(); it != _entries.end();) {
+    auto& [actor, afterImageFxData] = *it;
+    fadeAfterImages(afterImageFxData, delta);
+
+    if (!afterImageFxData.isSpawning) {
+      if (afterImageFxData.numActiveAfterImages == 0) {
+        releaseAfterImages(afterImageFxData);
+        it = _entries.erase(it);
+        continue;
       }
+      it++;
+      continue;
+    }
+
+    afterImageFxData.timerInSec += delta;
+    if (afterImageFxData.timerInSec >= afterImageFxData.intervalInSec) {
+      spawnAfterImage(actor, afterImageFxData);
+      afterImageFxData.timerInSec = 0.0f;
     }
+    it++;
   }
 }
 
-}  // namespace
-
-void AfterImageFxManager::update(const float delta) {
-  for (auto& [node, afterImageFxData] : _entries) {
-    if (afterImageFxData.timerInSec < afterImageFxData.intervalInSec) {
-      afterImageFxData.timerInSec += delta;
-      continue;
-    }
+bool AfterImageFxManager::registerActor(const StaticActor* actor,
+                                        const Color3B& color,
+                                        const float durationInSec,
+                                        const float intervalInSec) {
+  const auto it = _entries.find(actor);
+  if (it != _entries.end() && it->second.isSpawning) {
+    VGLOG(LOG_ERR, "Failed to register actor to AfterImageFxManager, err: [already registered].");
+    return false;
+  }
 
-    createAfterImage(node, afterImageFxData.color, afterImageFxData.durationInSec);
-    afterImageFxData.timerInSec = 0.0f;
+  // If the actor is re-registered while its afterimages are still fading out,
+  // keep using the same ring buffer as long as it is large enough.
+  AfterImageFxData& afterImageFxData = _entries[actor];
+  afterImageFxData.color = color;
+  afterImageFxData.durationInSec = durationInSec;
+  afterImageFxData.intervalInSec = intervalInSec;
+  afterImageFxData.timerInSec = 0.0f;
+  afterImageFxData.isSpawning = true;
+
+  if (!allocateAfterImages(actor, afterImageFxData)) {
+    _entries.erase(actor);
+    return false;
   }
+  return true;
 }
 
-bool AfterImageFxManager::registerNode(const Node* node,
-                                       const Color3B& color,
-                                       const float durationInSec,
-                                       const float intervalInSec) {
-  const auto it = _entries.find(node);
-  if (it != _entries.end()) {
-    VGLOG(LOG_ERR, "Failed to register node to AfterImageFxManager, err: [already registered].");
+bool AfterImageFxManager::unregisterActor(const StaticActor* actor) {
+  const auto it = _entries.find(actor);
+  if (it == _entries.end() || !it->second.isSpawning) {
+    VGLOG(LOG_ERR, "Failed to unregister actor from AfterImageFxManager, err: [actor hasn't been registered].");
     return false;
   }
 
-  _entries[node] = AfterImageFxData{color, durationInSec, intervalInSec, 0.0f};
+  it->second.isSpawning = false;
   return true;
 }
 
-bool AfterImageFxManager::unregisterNode(const ax::Node* node) {
-  const auto it = _entries.find(node);
-  if (it == _entries.end()) {
-    VGLOG(LOG_ERR, "Failed to register node to AfterImageFxManager, err: [node hasn't been registered].");
+void AfterImageFxManager::dropActor(const StaticActor* actor) {
+  // Its remaining afterimages are still faded out, which no longer refers to the actor.
+  if (const auto it = _entries.find(actor); it != _entries.end()) {
+    it->second.isSpawning = false;
+  }
+}
+
+bool AfterImageFxManager::allocateAfterImages(const StaticActor* actor,
+                                              AfterImageFxData& afterImageFxData) {
+  const SpriteBatchNode* spriteBatchNode = actor->getBodySpritesheet();
+  if (!spriteBatchNode) {
+    VGLOG(LOG_ERR, "Failed to allocate afterimages, err: [actor has no sprite batch].");
     return false;
   }
 
-  _entries.erase(it);
+  // At most (durationInSec / intervalInSec) afterimages are visible at the same time.
+  const int capacity = static_cast<int>(std::ceil(afterImageFxData.durationInSec /
+                                                  afterImageFxData.intervalInSec)) + 1;
+  Texture2D* texture = spriteBatchNode->getTexture();
+  if (afterImageFxData.texture == texture &&
+      static_cast<int>(afterImageFxData.afterImages.size()) >= capacity) {
+    return true;
+  }
+
+  releaseAfterImages(afterImageFxData);
+  afterImageFxData.texture = texture;
+  afterImageFxData.afterImages.resize(capacity);
+
+  // The afterimages are drawn right behind the actor's body, by the batch of the actor's texture.
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  const int zOrder = spriteBatchNode->getLocalZOrder() - 1;
+  for (auto& afterImage : afterImageFxData.afterImages) {
+    afterImage.sprite = Sprite::createWithTexture(texture);
+    afterImage.sprite->setVisible(false);
+    afterImage.sprite->retain();
+    gmMgr->getSpriteBatchManager()->addSprite(afterImage.sprite, texture, zOrder);
+  }
   return true;
 }
 
+void AfterImageFxManager::spawnAfterImage(const StaticActor* actor,
+                                          AfterImageFxData& afterImageFxData) {
+  const Sprite* sprite = actor->getBodySprite();
+  const SpriteBatchNode* spriteBatchNode = actor->getBodySpritesheet();
+  if (!sprite || !spriteBatchNode || !sprite->isVisible()) {
+    return;
+  }
+
+  // The actor's spritesheet has been replaced since the afterimages were allocated.
+  if (spriteBatchNode->getTexture() != afterImageFxData.texture &&
+      !allocateAfterImages(actor, afterImageFxData)) {
+    return;
+  }
+
+  // Overwrite the oldest afterimage.
+  const int capacity = static_cast<int>(afterImageFxData.afterImages.size());
+  AfterImage& afterImage = afterImageFxData.afterImages[afterImageFxData.nextAfterImageIdx];
+  afterImageFxData.nextAfterImageIdx = (afterImageFxData.nextAfterImageIdx + 1) % capacity;
+  if (!afterImage.isActive) {
+    afterImageFxData.numActiveAfterImages++;
+  }
+
+  afterImage.ageInSec = 0.0f;
+  afterImage.isActive = true;
+  afterImage.sprite->setSpriteFrame(sprite->getSpriteFrame());
+  afterImage.sprite->setPosition(sprite->getPosition());
+  afterImage.sprite->setScale(sprite->getScale());
+  afterImage.sprite->setRotation(sprite->getRotation());
+  afterImage.sprite->setFlippedX(sprite->isFlippedX());
+  afterImage.sprite->setColor(afterImageFxData.color);
+  afterImage.sprite->setOpacity(kAfterImageOpacity);
+  afterImage.sprite->setVisible(true);
+}
+
+void AfterImageFxManager::fadeAfterImages(AfterImageFxData& afterImageFxData, const float delta) {
+  if (afterImageFxData.numActiveAfterImages == 0) {
+    return;
+  }
+
+  for (auto& afterImage : afterImageFxData.afterImages) {
+    if (!afterImage.isActive) {
+      continue;
+    }
+
+    afterImage.ageInSec += delta;
+    if (afterImage.ageInSec >= afterImageFxData.durationInSec) {
+      afterImage.sprite->setVisible(false);
+      afterImage.isActive = false;
+      afterImageFxData.numActiveAfterImages--;
+      continue;
+    }
+
+    const float remaining = 1.0f - afterImage.ageInSec / afterImageFxData.durationInSec;
+    afterImage.sprite->setOpacity(static_cast<uint8_t>(kAfterImageOpacity * remaining));
+  }
+}
+
+void AfterImageFxManager::releaseAfterImages(AfterImageFxData& afterImageFxData) {
+  for (auto& afterImage : afterImageFxData.afterImages) {
+    afterImage.sprite->removeFromParent();
+    afterImage.sprite->release();
+  }
+  afterImageFxData.afterImages.clear();
+  afterImageFxData.texture = nullptr;
+  afterImageFxData.nextAfterImageIdx = 0;
+  afterImageFxData.numActiveAfterImages = 0;
+}
+
 }  // namespace requiem
@@ -4,32 +4,68 @@
 #define REQUIEM_AFTER_IMAGE_FX_MANAGER_H_
 
 #include <unordered_map>
+#include <vector>
 
 #include <axmol.h>
 
+#include "StaticActor.h"
+
 namespace requiem {
 
+// Each registered actor owns a ring buffer of afterimage sprites which are
+// allocated upon registration, drawn by the sprite batch of the actor's texture
+// and reused in place, so nothing is allocated while the fx is active.
 class AfterImageFxManager final {
  public:
+  AfterImageFxManager() = default;
+  AfterImageFxManager(const AfterImageFxManager&) = delete;
+  AfterImageFxManager& operator=(const AfterImageFxManager&) = delete;
+  ~AfterImageFxManager();
+
   void update(const float delta);
 
-  bool registerNode(const ax::Node* node,
-                    const ax::Color3B& color,
-                    const float durationInSec,
-                    const float intervalInSec);
-  bool unregisterNode(const ax::Node* node);
+  bool registerActor(const StaticActor* actor,
+                     const ax::Color3B& color,
+                     const float durationInSec,
+                     const float intervalInSec);
+  bool unregisterActor(const StaticActor* actor);
+  // Like unregisterActor(), but it's fine if the actor hasn't been registered.
+  // Must be called before a registered actor is removed or destroyed.
+  void dropActor(const StaticActor* actor);
+
+  inline bool isEmpty() const { return _entries.empty(); }
 
   static inline const ax::Color3B kPlayerAfterImageColor{55, 66, 189};
+  static inline constexpr uint8_t kAfterImageOpacity = 80;
 
  private:
+  struct AfterImage final {
+    ax::Sprite* sprite{};
+    float ageInSec{};
+    bool isActive{};
+  };
+
   struct AfterImageFxData final {
     ax::Color3B color;
-    float durationInSec;
-    float intervalInSec;
+    float durationInSec{};
+    float intervalInSec{};
     float timerInSec{};
+    // The texture which the afterimage sprites were created from.
+    ax::Texture2D* texture{};
+    std::vector<AfterImage> afterImages;
+    int nextAfterImageIdx{};
+    int numActiveAfterImages{};
+    // False if the actor has been unregistered, in which case
+    // the remaining afterimages are still faded out.
+    bool isSpawning{};
   };
 
-  std::unordered_map<const ax::Node*, AfterImageFxData> _entries;
+  bool allocateAfterImages(const StaticActor* actor, AfterImageFxData& afterImageFxData);
+  void spawnAfterImage(const StaticActor* actor, AfterImageFxData& afterImageFxData);
+  void fadeAfterImages(AfterImageFxData& afterImageFxData, const float delta);
+  void releaseAfterImages(AfterImageFxData& afterImageFxData);
+
+  std::unordered_map<const StaticActor*, AfterImageFxData> _entries;
 };
 
 }  // namespace requiem
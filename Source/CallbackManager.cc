@@ -2,42 +2,203 @@
 
 #include "CallbackManager.h"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace std;
-USING_NS_AX;
 
 namespace requiem {
 
+namespace {
+
+// The bucket (at the given level of the timer wheel) which the tick falls into.
+inline int getSlotIdx(const uint64_t tick, const int level, const int numSlotsPerLevelBits) {
+  return static_cast<int>((tick >> (level * numSlotsPerLevelBits)) & ((1 << numSlotsPerLevelBits) - 1));
+}
+
+}  // namespace
+
 CallbackManager& CallbackManager::the() {
   static CallbackManager instance;
   return instance;
 }
 
-uint64_t CallbackManager::runAfter(function<void (const CallbackManager::CallbackId)>&& userCallback, float delay) {
+CallbackManager::CallbackManager() {
+  for (auto& wheel : _wheels) {
+    wheel.fill(kNil);
+  }
+  _timers.reserve(kInitialTimerPoolSize);
+  _freeTimerIndices.reserve(kInitialTimerPoolSize);
+}
+
+void CallbackManager::update(const float delta) {
+  _accumulatedTimeInSec += delta;
+  while (_accumulatedTimeInSec >= kTickIntervalInSec) {
+    _accumulatedTimeInSec -= kTickIntervalInSec;
+    tick();
+  }
+}
+
+CallbackManager::CallbackId CallbackManager::runAfter(function<void (const CallbackManager::CallbackId)>&& userCallback,
+                                                      float delay) {
   if (delay == 0) {
     userCallback(0);
     return 0;
   }
 
-  const CallbackId id = _nextCallbackId++;
-  auto cancellableUserCallback = [this, id, callback = std::move(userCallback)]() {
-    const auto it = _cancelledCallbackIds.find(id);
-    if (it != _cancelledCallbackIds.end()) {
-      _cancelledCallbackIds.erase(it);
-      return;
+  // A callback always runs on a future tick, never on the one being processed.
+  // A negative delay is clamped, so that the callback runs on the next tick.
+  const float clampedDelay = std::max(0.0f, delay);
+  const uint64_t numTicks = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clampedDelay / kTickIntervalInSec)));
+
+  const uint32_t timerIdx = allocateTimer();
+  Timer& timer = _timers[timerIdx];
+  timer.callback = std::move(userCallback);
+  timer.expirationTick = _currentTick + numTicks;
+  timer.isPending = true;
+  link(timerIdx);
+  _numPendingCallbacks++;
+
+  return toCallbackId(timerIdx, timer.generation);
+}
+
+void CallbackManager::cancel(const CallbackManager::CallbackId callbackId) {
+  const uint32_t timerIdx = static_cast<uint32_t>(callbackId & UINT32_MAX);
+  const uint32_t generation = static_cast<uint32_t>(callbackId >> 32);
+  if (timerIdx >= _timers.size()) {
+    return;
+  }
+
+  // The callback has already run or has already been cancelled.
+  Timer& timer = _timers[timerIdx];
+  if (!timer.isPending || timer.generation != generation) {
+    return;
+  }
+
+  unlink(timerIdx);
+  freeTimer(timerIdx);
+  _numPendingCallbacks--;
+}
+
+void CallbackManager::clear() {
+  for (auto& wheel : _wheels) {
+    wheel.fill(kNil);
+  }
+
+  // The timers are recycled rather than discarded, so that the CallbackIds which have
+  // been handed out so far can never cancel the timers scheduled from now on.
+  for (uint32_t timerIdx = 0; timerIdx < _timers.size(); timerIdx++) {
+    if (_timers[timerIdx].isPending) {
+      _timers[timerIdx].prev = kNil;
+      _timers[timerIdx].next = kNil;
+      freeTimer(timerIdx);
+    }
+  }
+  _currentTick = 0;
+  _accumulatedTimeInSec = 0.0f;
+  _numPendingCallbacks = 0;
+}
+
+void CallbackManager::tick() {
+  _currentTick++;
+
+  // Whenever a lower level wraps around, move the timers in the
+  // next bucket of the upper level down to the lower levels.
+  for (int level = 1; level < kNumLevels; level++) {
+    if (getSlotIdx(_currentTick, level - 1, kNumSlotsPerLevelBits) != 0) {
+      break;
     }
+    cascade(level);
+  }
+
+  // The callbacks may schedule or cancel other callbacks,
+  // so always pop the first timer from the bucket.
+  uint32_t& head = _wheels[0][getSlotIdx(_currentTick, 0, kNumSlotsPerLevelBits)];
+  while (head != kNil) {
+    const uint32_t timerIdx = head;
+    Timer& timer = _timers[timerIdx];
+    unlink(timerIdx);
+
+    const CallbackId id = toCallbackId(timerIdx, timer.generation);
+    auto callback = std::move(timer.callback);
+    freeTimer(timerIdx);
+    _numPendingCallbacks--;
     callback(id);
-  };
+  }
+}
+
+void CallbackManager::cascade(const int level) {
+  uint32_t& head = _wheels[level][getSlotIdx(_currentTick, level, kNumSlotsPerLevelBits)];
+  while (head != kNil) {
+    const uint32_t timerIdx = head;
+    unlink(timerIdx);
+    link(timerIdx);
+  }
+}
+
+void CallbackManager::link(const uint32_t timerIdx) {
+  Timer& timer = _timers[timerIdx];
+  const uint64_t numTicksLeft = timer.expirationTick - _currentTick;
+
+  // Pick the lowest level whose span covers the remaining ticks.
+  int level = 0;
+  while (level < kNumLevels - 1 && numTicksLeft >= (uint64_t{1} << ((level + 1) * kNumSlotsPerLevelBits))) {
+    level++;
+  }
 
-  _scene->runAction(Sequence::createWithTwoActions(
-    DelayTime::create(delay),
-    CallFunc::create(cancellableUserCallback)
-  ));
+  // Timers further than the span of the whole wheel are parked in the furthest
+  // bucket of the top level, and are re-linked when that bucket is cascaded.
+  const uint64_t maxNumTicksLeft = (uint64_t{1} << (kNumLevels * kNumSlotsPerLevelBits)) -
+                                   (uint64_t{1} << ((kNumLevels - 1) * kNumSlotsPerLevelBits));
+  const uint64_t tick = _currentTick + std::min(numTicksLeft, maxNumTicksLeft);
+  const int slotIdx = getSlotIdx(tick, level, kNumSlotsPerLevelBits);
+  uint32_t& head = _wheels[level][slotIdx];
 
-  return id;
+  timer.level = static_cast<uint8_t>(level);
+  timer.slotIdx = static_cast<uint8_t>(slotIdx);
+  timer.prev = kNil;
+  timer.next = head;
+  if (head != kNil) {
+    _timers[head].prev = timerIdx;
+  }
+  head = timerIdx;
 }
 
-void CallbackManager::cancel(const CallbackManager::CallbackId callbackId) {
-  _cancelledCallbackIds.emplace(callbackId);
+void CallbackManager::unlink(const uint32_t timerIdx) {
+  Timer& timer = _timers[timerIdx];
+  if (timer.prev != kNil) {
+    _timers[timer.prev].next = timer.next;
+  } else {
+    _wheels[timer.level][timer.slotIdx] = timer.next;
+  }
+  if (timer.next != kNil) {
+    _timers[timer.next].prev = timer.prev;
+  }
+  timer.prev = kNil;
+  timer.next = kNil;
+}
+
+uint32_t CallbackManager::allocateTimer() {
+  if (!_freeTimerIndices.empty()) {
+    const uint32_t timerIdx = _freeTimerIndices.back();
+    _freeTimerIndices.pop_back();
+    return timerIdx;
+  }
+
+  _timers.emplace_back();
+  return static_cast<uint32_t>(_timers.size() - 1);
+}
+
+void CallbackManager::freeTimer(const uint32_t timerIdx) {
+  Timer& timer = _timers[timerIdx];
+  timer.callback = nullptr;
+  timer.isPending = false;
+  timer.generation++;
+  _freeTimerIndices.push_back(timerIdx);
+}
+
+CallbackManager::CallbackId CallbackManager::toCallbackId(const uint32_t timerIdx, const uint32_t generation) {
+  return (static_cast<CallbackId>(generation) << 32) | timerIdx;
 }
 
 }  // namespace requiem
@@ -3,31 +3,74 @@
 #ifndef REQUIEM_CALLBACK_MANAGER_H_
 #define REQUIEM_CALLBACK_MANAGER_H_
 
+#include <array>
 #include <cstdint>
 #include <functional>
-#include <unordered_set>
-
-#include <axmol.h>
+#include <vector>
 
 namespace requiem {
 
+// Runs delayed callbacks using a hierarchical timer wheel, which is ticked
+// by GameScene::update() and hence stops ticking while the game is paused.
+// Scheduling and cancelling a callback are both O(1), and the timers are
+// stored in a pool of slots which are recycled after they fire.
 class CallbackManager final {
  public:
   using CallbackId = uint64_t;
   static CallbackManager& the();
 
+  void update(const float delta);
+
   CallbackId runAfter(std::function<void (const CallbackId id)>&& userCallback, float delay);
   void cancel(const CallbackId id);
 
-  inline void setScene(ax::Scene* scene) { _scene = scene; }
+  // Drops all pending callbacks without running them.
+  void clear();
+
+  inline int getNumPendingCallbacks() const { return _numPendingCallbacks; }
+
+  static inline constexpr float kTickIntervalInSec = 1.0f / 60.0f;
 
  private:
-  CallbackManager() : _scene() {}
+  static inline constexpr int kNumLevels = 3;
+  static inline constexpr int kNumSlotsPerLevelBits = 6;
+  static inline constexpr int kNumSlotsPerLevel = 1 << kNumSlotsPerLevelBits;
+  static inline constexpr uint32_t kNil = UINT32_MAX;
+  static inline constexpr size_t kInitialTimerPoolSize = 256;
+
+  struct Timer final {
+    std::function<void (const CallbackId id)> callback;
+    uint64_t expirationTick{};
+    // Incremented each time this slot is recycled, so that a stale
+    // CallbackId can never cancel the timer which reuses its slot.
+    uint32_t generation{};
+    // The bucket of the timer wheel which this timer is linked into.
+    uint8_t level{};
+    uint8_t slotIdx{};
+    uint32_t prev{kNil};
+    uint32_t next{kNil};
+    bool isPending{};
+  };
+
+  using Wheel = std::array<uint32_t, kNumSlotsPerLevel>;
+
+  CallbackManager();
+
+  void tick();
+  void cascade(const int level);
+  void link(const uint32_t timerIdx);
+  void unlink(const uint32_t timerIdx);
+  uint32_t allocateTimer();
+  void freeTimer(const uint32_t timerIdx);
 
-  static inline CallbackId _nextCallbackId{1};
+  static CallbackId toCallbackId(const uint32_t timerIdx, const uint32_t generation);
 
-  ax::Scene* _scene;
-  std::unordered_set<CallbackId> _cancelledCallbackIds;
+  std::array<Wheel, kNumLevels> _wheels;
+  std::vector<Timer> _timers;
+  std::vector<uint32_t> _freeTimerIndices;
+  uint64_t _currentTick{};
+  float _accumulatedTimeInSec{};
+  int _numPendingCallbacks{};
 };
 
 }  // namespace requiem
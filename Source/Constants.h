@@ -76,6 +76,8 @@ inline constexpr int kFx = 45;
 
 inline constexpr int kDefault = 60;
 
+inline constexpr int kDebugOverlay = 78;
+inline constexpr int kFloatingHealthBar = 79;
 inline constexpr int kFloatingDamage = 80;
 inline constexpr int kNotification = 82;
 inline constexpr int kQuestHint = 84;
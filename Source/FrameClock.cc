@@ -0,0 +1,25 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#include "FrameClock.h"
+
+using namespace std;
+
+namespace requiem {
+
+FrameClock& FrameClock::the() {
+  static FrameClock instance;
+  return instance;
+}
+
+FrameClock::FrameClock() : _startTime{chrono::steady_clock::now()} {}
+
+void FrameClock::tick(const float delta) {
+  using namespace std::chrono;
+  _realTimeMs = duration_cast<milliseconds>(steady_clock::now() - _startTime).count();
+  _realDelta = delta;
+  _gameDelta = (_isPaused) ? 0 : delta * _timeScale;
+  _gameTimeInSec += _gameDelta;
+  _frameCount++;
+}
+
+}  // namespace requiem
@@ -0,0 +1,50 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_FRAME_CLOCK_H_
+#define REQUIEM_FRAME_CLOCK_H_
+
+#include <chrono>
+#include <cstdint>
+
+namespace requiem {
+
+// Samples a monotonic clock once per frame in GameScene::update(), so that
+// all gameplay timing within a frame agrees on the same timestamp.
+//
+// Real time always advances, whereas game time stops while the game is paused
+// and advances at `timeScale` times the real speed (e.g., for slow motion).
+class FrameClock final {
+ public:
+  static FrameClock& the();
+
+  void tick(const float delta);
+
+  inline uint64_t getFrameCount() const { return _frameCount; }
+  inline uint64_t getRealTimeMs() const { return _realTimeMs; }
+  inline uint64_t getGameTimeMs() const { return static_cast<uint64_t>(_gameTimeInSec * 1000); }
+  inline float getRealDelta() const { return _realDelta; }
+  inline float getGameDelta() const { return _gameDelta; }
+
+  inline bool isPaused() const { return _isPaused; }
+  inline void setPaused(const bool paused) { _isPaused = paused; }
+  inline float getTimeScale() const { return _timeScale; }
+  inline void setTimeScale(const float timeScale) { _timeScale = timeScale; }
+
+  static inline constexpr float kMaxTimeScale = 4.0f;
+
+ private:
+  FrameClock();
+
+  const std::chrono::steady_clock::time_point _startTime;
+  uint64_t _frameCount{};
+  uint64_t _realTimeMs{};
+  double _gameTimeInSec{};
+  float _realDelta{};
+  float _gameDelta{};
+  float _timeScale{1.0f};
+  bool _isPaused{};
+};
+
+}  // namespace requiem
+
+#endif  // REQUIEM_FRAME_CLOCK_H_
@@ -2,14 +2,19 @@
 
 #include "FxManager.h"
 
+#include <algorithm>
+
 #include "Assets.h"
 #include "Constants.h"
 #include "StaticActor.h"
+#include "TextureManager.h"
 #include "DynamicActor.h"
 #include "character/Character.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
 #include "util/AxUtil.h"
+#include "util/Logger.h"
+#include "util/StringUtil.h"
 
 using namespace std;
 using namespace requiem::assets;
@@ -17,6 +22,46 @@ USING_NS_AX;
 
 namespace requiem {
 
+FxManager::~FxManager() {
+  for (auto& [_, fxPool] : _fxPools) {
+    for (auto& pooledFx : fxPool.instances) {
+      pooledFx.sprite->removeFromParent();
+      pooledFx.sprite->release();
+    }
+  }
+}
+
+void FxManager::update(const float delta) {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+
+  for (auto& [_, fxPool] : _fxPools) {
+    if (!fxPool.numActive) {
+      continue;
+    }
+
+    const auto& frames = fxPool.animation->getFrames();
+    const float frameInterval = fxPool.animation->getDelayPerUnit();
+    for (auto& pooledFx : fxPool.instances) {
+      if (!pooledFx.isActive) {
+        continue;
+      }
+
+      pooledFx.timerInSec += delta;
+      const int frameIdx = static_cast<int>(pooledFx.timerInSec / frameInterval);
+
+      if (frameIdx >= static_cast<int>(frames.size())) {
+        pooledFx.sprite->setVisible(false);
+        pooledFx.isActive = false;
+        fxPool.numActive--;
+        _numActivePooledFx--;
+      } else if (frameIdx != pooledFx.frameIdx && gmMgr->isInCullingRect(pooledFx.sprite->getPosition())) {
+        pooledFx.frameIdx = frameIdx;
+        pooledFx.sprite->setSpriteFrame(frames.at(frameIdx)->getSpriteFrame());
+      }
+    }
+  }
+}
+
 void FxManager::createDustFx(const Character* c) {
   if (!c) {
     return;
@@ -25,7 +70,7 @@ void FxManager::createDustFx(const Character* c) {
   const b2Vec2& bodyPos = c->getBody()->GetPosition();
   const float x = bodyPos.x * kPpm;
   const float y = (bodyPos.y - .1f) * kPpm;
-  createAnimation(kDustDir, "white", x, y, 1, 10);
+  playPooledFx(kDustDir, "white", x, y, 10);
 }
 
 void FxManager::createHitFx(const Character* c) {
@@ -36,13 +81,13 @@ void FxManager::createHitFx(const Character* c) {
   const b2Vec2& bodyPos = c->getBody()->GetPosition();
   const float x = bodyPos.x * kPpm;
   const float y = bodyPos.y * kPpm;
-  createAnimation(kHitDir, "normal", x, y, 1, 4);
+  playPooledFx(kHitDir, "normal", x, y, 4);
 }
 
 Sprite* FxManager::createHintBubbleFx(const b2Body* body,
                                       const string& framesName) {
   if (!body) {
-    return;
+    return nullptr;
   }
 
   const b2Vec2& bodyPos = body->GetPosition();
@@ -57,45 +102,25 @@ Sprite* FxManager::createAnimation(const fs::path& textureResDirPath,
                                    const float y,
                                    const unsigned int loopCount,
                                    const float frameInterval) {
-  // If the ax::Animation* is not present in cache,
-  // then create one and cache this animation object.
-  //
-  // Texture/fx/dust/dust_white/0.png
-  // |_____________| |__||____|
-  // textureResDirPath |  framesName
-  //            framesNamePrefix
-  const string framesNamePrefix = StaticActor::getLastDirName(textureResDirPath);
-  const fs::path cacheKey = textureResDirPath / (framesNamePrefix + "_" + framesName);
-
-  if (_animationCache.find(cacheKey) == _animationCache.end()) {
-    Animation* animation = StaticActor::createAnimation(textureResDirPath, framesName, frameInterval / kPpm);
-    _animationCache.emplace(cacheKey, animation);
-  }
+  Animation* animation = getOrCreateAnimation(textureResDirPath, framesName, frameInterval);
 
   // Select the first frame (e.g., dust_white/0.png) as the default look of the sprite.
-  Sprite* sprite = Sprite::createWithSpriteFrameName(framesNamePrefix + "_" +
-                                                     framesName + "/0.png");
+  Sprite* sprite = Sprite::createWithSpriteFrame(animation->getFrames().front()->getSpriteFrame());
   sprite->setPosition(x, y);
 
-  string spritesheetFilePath = StaticActor::getSpritesheetFilePath(textureResDirPath);
-  SpriteBatchNode* spritesheet = SpriteBatchNode::create(spritesheetFilePath);
-  spritesheet->addChild(sprite);
-  spritesheet->getTexture()->setAliasTexParameters();
-
+  // All the fx sharing the same spritesheet are drawn by the same batch.
   auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
-  ax_util::addChildWithParentCameraMask(gmMgr->getLayer(), spritesheet, z_order::kFx);
+  gmMgr->getSpriteBatchManager()->addSprite(
+      sprite, StaticActor::getSpritesheetFilePath(textureResDirPath), z_order::kFx);
 
   const bool shouldRepeatForever = loopCount == static_cast<unsigned int>(-1);
-  auto animate = Animate::create(_animationCache[cacheKey]);
+  auto animate = Animate::create(animation);
   if (shouldRepeatForever) {
     sprite->runAction(RepeatForever::create(animate));
   } else {
-    auto cleanup = [gmMgr, spritesheet]() {
-      gmMgr->getLayer()->removeChild(spritesheet);
-    };
     sprite->runAction(Sequence::createWithTwoActions(
         Repeat::create(animate, loopCount),
-        CallFunc::create(cleanup)
+        RemoveSelf::create()
       )
     );
   }
@@ -108,4 +133,105 @@ void FxManager::removeFx(Sprite* sprite) {
   sprite->removeFromParent();
 }
 
+vector<string> FxManager::getPoolReport() const {
+  vector<string> report;
+  for (const auto& [cacheKey, fxPool] : _fxPools) {
+    report.push_back(string_util::format("%s: %d/%d active, peak: %d, overflows: %d",
+                                         cacheKey.filename().c_str(),
+                                         fxPool.numActive,
+                                         static_cast<int>(fxPool.instances.size()),
+                                         fxPool.peakNumActive,
+                                         fxPool.numOverflows));
+  }
+  return report;
+}
+
+void FxManager::playPooledFx(const fs::path& textureResDirPath,
+                             const string& framesName,
+                             const float x,
+                             const float y,
+                             const float frameInterval) {
+  FxPool* fxPool = getOrCreateFxPool(textureResDirPath, framesName, frameInterval);
+  if (!fxPool) {
+    return;
+  }
+
+  // Take an idle instance. If there are none left, recycle the one
+  // that has been playing for the longest time.
+  auto it = std::find_if(fxPool->instances.begin(), fxPool->instances.end(),
+                         [](const PooledFx& pooledFx) { return !pooledFx.isActive; });
+  if (it == fxPool->instances.end()) {
+    it = std::max_element(fxPool->instances.begin(), fxPool->instances.end(),
+                          [](const PooledFx& a, const PooledFx& b) { return a.timerInSec < b.timerInSec; });
+    fxPool->numOverflows++;
+  } else {
+    fxPool->numActive++;
+    _numActivePooledFx++;
+    fxPool->peakNumActive = std::max(fxPool->peakNumActive, fxPool->numActive);
+  }
+
+  it->timerInSec = 0.0f;
+  it->frameIdx = 0;
+  it->isActive = true;
+  it->sprite->setSpriteFrame(fxPool->animation->getFrames().front()->getSpriteFrame());
+  it->sprite->setPosition(x, y);
+  it->sprite->setVisible(true);
+}
+
+FxManager::FxPool* FxManager::getOrCreateFxPool(const fs::path& textureResDirPath,
+                                                const string& framesName,
+                                                const float frameInterval) {
+  const string framesNamePrefix = StaticActor::getLastDirName(textureResDirPath);
+  const fs::path poolKey = textureResDirPath / (framesNamePrefix + "_" + framesName);
+
+  auto it = _fxPools.find(poolKey);
+  if (it != _fxPools.end()) {
+    return &it->second;
+  }
+
+  Animation* animation = getOrCreateAnimation(textureResDirPath, framesName, frameInterval);
+  if (!animation || animation->getFrames().empty()) {
+    VGLOG(LOG_ERR, "Failed to create fx pool for [%s].", poolKey.c_str());
+    return nullptr;
+  }
+
+  FxPool fxPool;
+  fxPool.animation = animation;
+  fxPool.instances.resize(kFxPoolCapacity);
+
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  const fs::path spritesheetFilePath = StaticActor::getSpritesheetFilePath(textureResDirPath);
+  for (auto& pooledFx : fxPool.instances) {
+    pooledFx.sprite = Sprite::createWithSpriteFrame(animation->getFrames().front()->getSpriteFrame());
+    pooledFx.sprite->setVisible(false);
+    pooledFx.sprite->retain();
+    gmMgr->getSpriteBatchManager()->addSprite(pooledFx.sprite, spritesheetFilePath, z_order::kFx);
+  }
+
+  return &_fxPools.emplace(poolKey, std::move(fxPool)).first->second;
+}
+
+Animation* FxManager::getOrCreateAnimation(const fs::path& textureResDirPath,
+                                           const string& framesName,
+                                           const float frameInterval) {
+  // If the ax::Animation* is not present in cache,
+  // then create one and cache this animation object.
+  //
+  // Texture/fx/dust/dust_white/0.png
+  // |_____________| |__||____|
+  // textureResDirPath |  framesName
+  //            framesNamePrefix
+  const string framesNamePrefix = StaticActor::getLastDirName(textureResDirPath);
+  const fs::path cacheKey = textureResDirPath / (framesNamePrefix + "_" + framesName);
+  TextureManager::the().acquire(StaticActor::getSpritesheetFilePath(textureResDirPath),
+                                TextureManager::Category::FX);
+
+  auto it = _animationCache.find(cacheKey);
+  if (it == _animationCache.end()) {
+    Animation* animation = StaticActor::createAnimation(textureResDirPath, framesName, frameInterval / kPpm);
+    it = _animationCache.emplace(cacheKey, animation).first;
+  }
+  return it->second;
+}
+
 }  // namespace requiem
@@ -6,6 +6,7 @@
 #include <filesystem>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <axmol.h>
 
@@ -17,6 +18,13 @@ class Character;
 
 class FxManager final {
  public:
+  FxManager() = default;
+  FxManager(const FxManager&) = delete;
+  FxManager& operator=(const FxManager&) = delete;
+  ~FxManager();
+
+  void update(const float delta);
+
   void createDustFx(const Character* c);
   void createHitFx(const Character* c);
   ax::Sprite* createHintBubbleFx(const b2Body* body,
@@ -31,8 +39,46 @@ class FxManager final {
                               const unsigned int loopCount = 1,
                               const float frameInterval = 10.0f);
 
+  std::vector<std::string> getPoolReport() const;
+  inline bool hasActiveFx() const { return _numActivePooledFx > 0; }
+
+  static inline constexpr int kFxPoolCapacity = 16;
+
  private:
+  // Short-lived fx (e.g., dust, hit) are played by recycling a fixed number
+  // of sprites per effect, whose frames are advanced in update() rather than
+  // by ax::Animate actions. The frames of the fx outside of the culling rect
+  // aren't updated until they're back in it.
+  struct PooledFx final {
+    ax::Sprite* sprite{};
+    float timerInSec{};
+    int frameIdx{};
+    bool isActive{};
+  };
+
+  struct FxPool final {
+    ax::Animation* animation{};
+    std::vector<PooledFx> instances;
+    int numActive{};
+    int peakNumActive{};
+    int numOverflows{};
+  };
+
+  void playPooledFx(const std::filesystem::path& textureResDirPath,
+                    const std::string& framesName,
+                    const float x,
+                    const float y,
+                    const float frameInterval);
+  FxPool* getOrCreateFxPool(const std::filesystem::path& textureResDirPath,
+                            const std::string& framesName,
+                            const float frameInterval);
+  ax::Animation* getOrCreateAnimation(const std::filesystem::path& textureResDirPath,
+                                      const std::string& framesName,
+                                      const float frameInterval);
+
   std::unordered_map<std::filesystem::path, ax::Animation*> _animationCache;
+  std::unordered_map<std::filesystem::path, FxPool> _fxPools;
+  int _numActivePooledFx{};
 };
 
 }  // namespace requiem
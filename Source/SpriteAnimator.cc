@@ -0,0 +1,107 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#include "SpriteAnimator.h"
+
+#include <cmath>
+
+#include "util/Logger.h"
+
+using namespace std;
+USING_NS_AX;
+
+namespace requiem {
+
+void SpriteAnimator::update(const float delta) {
+  if (!_isPlaying) {
+    return;
+  }
+
+  _elapsed += delta * _speed;
+  if (_isCulled && !_onComplete) {
+    return;
+  }
+
+  // Skip the whole cycles at once when catching up.
+  if (_isLooping && _elapsed >= _animation->getDuration()) {
+    _elapsed = std::fmod(_elapsed, _animation->getDuration());
+  }
+
+  const int numFrames = static_cast<int>(_animation->getFrames().size());
+  const int prevFrameIdx = _frameIdx;
+  float frameDuration = getFrameDuration(_frameIdx);
+
+  // A long delta (e.g., after a hitch or being culled) may skip several frames at once.
+  while (_elapsed >= frameDuration) {
+    _elapsed -= frameDuration;
+    _frameIdx++;
+
+    if (_frameIdx >= numFrames) {
+      if (!_isLooping) {
+        // Keep showing the last frame, just like ax::Animate does.
+        _frameIdx = numFrames - 1;
+        showFrame(_frameIdx);
+        _isPlaying = false;
+
+        // The callback may play another animation or even destroy the owner,
+        // so nothing may touch `this` after invoking it.
+        if (_onComplete) {
+          std::function<void ()> onComplete = std::move(_onComplete);
+          _onComplete = nullptr;
+          onComplete();
+        }
+        return;
+      }
+      _frameIdx = 0;
+    }
+
+    frameDuration = getFrameDuration(_frameIdx);
+  }
+
+  if (_frameIdx != prevFrameIdx) {
+    showFrame(_frameIdx);
+  }
+}
+
+void SpriteAnimator::play(Animation* animation, const bool loop) {
+  // A zero-length animation would never advance past its first frame.
+  if (!_sprite || !animation || animation->getFrames().empty() || animation->getDuration() <= 0) {
+    VGLOG(LOG_ERR, "Failed to play animation: [%p] on sprite: [%p].", animation, _sprite);
+    return;
+  }
+
+  _animation = animation;
+  _onComplete = nullptr;
+  _frameIdx = 0;
+  _elapsed = 0;
+  _isLooping = loop;
+  _isPlaying = true;
+  showFrame(_frameIdx);
+}
+
+void SpriteAnimator::play(Animation* animation, std::function<void ()> onComplete) {
+  play(animation, /*loop=*/false);
+  if (_isPlaying) {
+    _onComplete = std::move(onComplete);
+  }
+}
+
+void SpriteAnimator::stop() {
+  _animation = nullptr;
+  _onComplete = nullptr;
+  _isPlaying = false;
+}
+
+void SpriteAnimator::setSprite(Sprite* sprite) {
+  stop();
+  _sprite = sprite;
+}
+
+float SpriteAnimator::getFrameDuration(const int frameIdx) const {
+  return _animation->getFrames().at(frameIdx)->getDelayUnits() * _animation->getDelayPerUnit();
+}
+
+void SpriteAnimator::showFrame(const int frameIdx) {
+  _sprite->setSpriteFrame(_animation->getFrames().at(frameIdx)->getSpriteFrame());
+}
+
+}  // namespace requiem
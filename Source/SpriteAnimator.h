@@ -0,0 +1,64 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_SPRITE_ANIMATOR_H_
+#define REQUIEM_SPRITE_ANIMATOR_H_
+
+#include <functional>
+
+#include <axmol.h>
+
+namespace requiem {
+
+// Plays an ax::Animation on a sprite without running any ax::Action.
+//
+// The current animation, frame index and elapsed time are plain data advanced
+// by update(), so switching animations doesn't allocate anything, and the
+// owner decides when (and how fast) its sprite is animated.
+class SpriteAnimator final {
+ public:
+  SpriteAnimator() = default;
+  SpriteAnimator(const SpriteAnimator&) = delete;
+  SpriteAnimator& operator=(const SpriteAnimator&) = delete;
+
+  void update(const float delta);
+
+  // Plays the animation from its first frame, either looping forever
+  // or only once, invoking `onComplete` (if any) after its last frame.
+  void play(ax::Animation* animation, const bool loop);
+  void play(ax::Animation* animation, std::function<void ()> onComplete);
+  void stop();
+
+  // The sprite must be set before playing any animation,
+  // and changing it stops the current animation.
+  void setSprite(ax::Sprite* sprite);
+
+  // While culled, the elapsed time keeps accumulating but no frame is shown,
+  // and the first update after that catches up by skipping to the right frame.
+  // An animation with a completion callback is never culled, since its callback
+  // may drive gameplay logic.
+  inline bool isCulled() const { return _isCulled; }
+  inline void setCulled(const bool culled) { _isCulled = culled; }
+
+  inline bool isPlaying() const { return _isPlaying; }
+  inline ax::Animation* getAnimation() const { return _animation; }
+  inline float getSpeed() const { return _speed; }
+  inline void setSpeed(const float speed) { _speed = speed; }
+
+ private:
+  float getFrameDuration(const int frameIdx) const;
+  void showFrame(const int frameIdx);
+
+  ax::Sprite* _sprite{};
+  ax::Animation* _animation{};
+  std::function<void ()> _onComplete;
+  int _frameIdx{};
+  float _elapsed{};
+  float _speed{1.0f};
+  bool _isLooping{};
+  bool _isPlaying{};
+  bool _isCulled{};
+};
+
+}  // namespace requiem
+
+#endif  // REQUIEM_SPRITE_ANIMATOR_H_
@@ -39,6 +39,12 @@ bool StaticActor::removeFromMap() {
 
   _isShownOnMap = false;
 
+  // The body sprite may live in a sprite batch shared with other actors
+  // rather than under _node, so detach it explicitly.
+  if (_bodySprite) {
+    _bodySprite->removeFromParent();
+  }
+
   auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
   gmMgr->getLayer()->removeChild(_node, true);
 
@@ -28,6 +28,10 @@ class StaticActor {
   virtual bool removeFromMap();
   virtual void setPosition(float x, float y);
 
+  // Pauses the cosmetic updates (e.g., animations) of this actor while it's
+  // far off screen. Most static actors don't have any.
+  virtual void setCulled(const bool culled) {}
+
   inline ax::Node* getNode() const { return _node; }
   inline ax::Sprite* getBodySprite() const { return _bodySprite; }
   inline ax::SpriteBatchNode* getBodySpritesheet() const { return _bodySpritesheet; }
@@ -0,0 +1,217 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#include "TextureManager.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "util/Logger.h"
+#include "util/StringUtil.h"
+
+namespace fs = std::filesystem;
+using namespace std;
+USING_NS_AX;
+
+namespace requiem {
+
+namespace {
+
+constexpr array<const char*, static_cast<size_t>(TextureManager::Category::SIZE)> kCategoryStr{{
+  "character",
+  "fx",
+  "item",
+  "object",
+  "parallax",
+  "lighting",
+  "tileset",
+}};
+
+inline float toMiB(const size_t bytes) {
+  return bytes / (1024.0f * 1024.0f);
+}
+
+}  // namespace
+
+TextureManager& TextureManager::the() {
+  static TextureManager instance;
+  return instance;
+}
+
+Texture2D* TextureManager::acquire(const fs::path& textureFilePath, const Category category) {
+  const string& key = textureFilePath.native();
+  _tick++;
+
+  auto it = _entries.find(key);
+  fs::path plistFilePath;
+  if (it != _entries.end()) {
+    plistFilePath = it->second.plistFilePath;
+  } else {
+    plistFilePath = textureFilePath;
+    plistFilePath.replace_extension(".plist");
+    if (!FileUtils::getInstance()->isFileExist(plistFilePath.native())) {
+      plistFilePath.clear();
+    }
+  }
+
+  // If this texture is a spritesheet, its frames may have been evicted
+  // from ax::SpriteFrameCache together with the texture, so add them back.
+  SpriteFrameCache* frameCache = SpriteFrameCache::getInstance();
+  if (!plistFilePath.empty() && !frameCache->isSpriteFramesWithFileLoaded(plistFilePath.native())) {
+    frameCache->addSpriteFramesWithFile(plistFilePath.native());
+  }
+
+  Texture2D* texture = Director::getInstance()->getTextureCache()->addImage(key);
+  if (!texture) {
+    VGLOG(LOG_ERR, "Failed to acquire texture [%s].", key.c_str());
+    return nullptr;
+  }
+
+  Entry& entry = (it != _entries.end()) ? it->second : addEntry(key, texture, category, plistFilePath);
+  entry.gameMaps.insert(_currentGameMap);
+  entry.lastUsedGameMapSeq = _gameMapSeq;
+  entry.lastUsedTick = _tick;
+  return texture;
+}
+
+void TextureManager::prefetch(const fs::path& textureFilePath, const Category category) {
+  const string& key = textureFilePath.native();
+  if (_entries.contains(key) || !_prefetchingTextures.insert(key).second) {
+    return;
+  }
+
+  // The callback is invoked on the main thread once the texture has been uploaded.
+  Director::getInstance()->getTextureCache()->addImageAsync(key, [this, key, category](Texture2D* texture) {
+    _prefetchingTextures.erase(key);
+    if (!texture) {
+      VGLOG(LOG_ERR, "Failed to prefetch texture [%s].", key.c_str());
+      return;
+    }
+    if (!_entries.contains(key)) {
+      addEntry(key, texture, category, {});
+      _numPrefetched++;
+    }
+  });
+}
+
+void TextureManager::beginGameMap(const fs::path& tmxTiledMapFilePath) {
+  _currentGameMap = tmxTiledMapFilePath.native();
+  _gameMapSeq++;
+}
+
+void TextureManager::evictUntilWithinBudget() {
+  if (getResidentBytes() <= _budgetBytes) {
+    return;
+  }
+
+  // Only the textures which are not used by the current game map are eligible,
+  // and the least recently used ones are evicted first.
+  vector<pair<uint64_t, string>> candidates;
+  for (const auto& [textureFilePath, entry] : _entries) {
+    if (entry.lastUsedGameMapSeq == _gameMapSeq) {
+      continue;
+    }
+    candidates.emplace_back(entry.lastUsedTick, textureFilePath);
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  for (const auto& [_, textureFilePath] : candidates) {
+    if (getResidentBytes() <= _budgetBytes) {
+      break;
+    }
+
+    auto it = _entries.find(textureFilePath);
+    if (!isIdle(it->first, it->second)) {
+      continue;
+    }
+    evict(it->first, it->second);
+    _entries.erase(it);
+  }
+
+  if (getResidentBytes() > _budgetBytes) {
+    VGLOG(LOG_WARN, "Resident textures [%.1f MiB] exceed the budget [%.1f MiB].",
+          toMiB(getResidentBytes()), toMiB(_budgetBytes));
+  }
+}
+
+size_t TextureManager::getResidentBytes() const {
+  return std::accumulate(_residentBytes.begin(), _residentBytes.end(), size_t{0});
+}
+
+size_t TextureManager::getResidentBytes(const Category category) const {
+  return _residentBytes[static_cast<size_t>(category)];
+}
+
+vector<string> TextureManager::getReport() const {
+  array<int, static_cast<size_t>(Category::SIZE)> numTextures{};
+  for (const auto& [_, entry] : _entries) {
+    numTextures[static_cast<size_t>(entry.category)]++;
+  }
+
+  vector<string> report;
+  report.push_back(string_util::format("textures: %.1f/%.1f MiB, %d resident, %d evicted, %d prefetched",
+                                       toMiB(getResidentBytes()), toMiB(_budgetBytes),
+                                       static_cast<int>(_entries.size()),
+                                       static_cast<int>(_numEvicted),
+                                       static_cast<int>(_numPrefetched)));
+  for (size_t i = 0; i < kCategoryStr.size(); i++) {
+    report.push_back(string_util::format("%s: %.1f MiB (%d)", kCategoryStr[i],
+                                         toMiB(_residentBytes[i]), numTextures[i]));
+  }
+  return report;
+}
+
+TextureManager::Entry& TextureManager::addEntry(const string& textureFilePath, Texture2D* texture,
+                                                const Category category, const fs::path& plistFilePath) {
+  Entry entry;
+  entry.category = category;
+  entry.bytes = static_cast<size_t>(texture->getPixelsWide()) * texture->getPixelsHigh() *
+                texture->getBitsPerPixelForFormat() / 8;
+
+  if (!plistFilePath.empty()) {
+    entry.plistFilePath = plistFilePath;
+    const ValueMap plist = FileUtils::getInstance()->getValueMapFromFile(plistFilePath.native());
+    if (const auto framesIt = plist.find("frames"); framesIt != plist.end()) {
+      for (const auto& [frameName, _] : framesIt->second.asValueMap()) {
+        entry.frameNames.push_back(frameName);
+      }
+    }
+  }
+
+  _residentBytes[static_cast<size_t>(category)] += entry.bytes;
+  return _entries.emplace(textureFilePath, std::move(entry)).first->second;
+}
+
+bool TextureManager::isIdle(const string& textureFilePath, const Entry& entry) const {
+  Texture2D* texture = Director::getInstance()->getTextureCache()->getTextureForKey(textureFilePath);
+  if (!texture) {
+    return true;
+  }
+
+  // A resident texture is retained once by ax::TextureCache and once by each
+  // of its sprite frames. Anything beyond that is a live sprite or batch node.
+  if (texture->getReferenceCount() > 1 + entry.frameNames.size()) {
+    return false;
+  }
+
+  // Animations hold onto sprite frames rather than the texture itself.
+  SpriteFrameCache* frameCache = SpriteFrameCache::getInstance();
+  return std::all_of(entry.frameNames.begin(), entry.frameNames.end(), [frameCache](const string& name) {
+    const SpriteFrame* frame = frameCache->getSpriteFrameByName(name);
+    return !frame || frame->getReferenceCount() <= 1;
+  });
+}
+
+void TextureManager::evict(const string& textureFilePath, const Entry& entry) {
+  if (!entry.plistFilePath.empty()) {
+    SpriteFrameCache::getInstance()->removeSpriteFramesFromFile(entry.plistFilePath.native());
+  }
+  Director::getInstance()->getTextureCache()->removeTextureForKey(textureFilePath);
+
+  _residentBytes[static_cast<size_t>(entry.category)] -= entry.bytes;
+  _numEvicted++;
+
+  VGLOG(LOG_INFO, "Evicted texture [%s] (%.1f MiB), last used on %d game map(s).",
+        textureFilePath.c_str(), toMiB(entry.bytes), static_cast<int>(entry.gameMaps.size()));
+}
+
+}  // namespace requiem
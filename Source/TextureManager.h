@@ -0,0 +1,91 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_TEXTURE_MANAGER_H_
+#define REQUIEM_TEXTURE_MANAGER_H_
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <axmol.h>
+
+namespace requiem {
+
+// Keeps track of the textures that the game loads into ax::TextureCache,
+// which systems use them and on which game maps they were last used.
+// On each game map transition, the least recently used textures which
+// are no longer referenced are evicted until the resident bytes fit
+// into the memory budget.
+class TextureManager final {
+ public:
+  enum class Category {
+    CHARACTER,
+    FX,
+    ITEM,
+    OBJECT,
+    PARALLAX,
+    LIGHTING,
+    TILESET,
+    SIZE
+  };
+
+  static TextureManager& the();
+
+  // Loads the texture (and its spritesheet plist, if any) if it's not resident yet,
+  // and marks it as used by the current game map.
+  // This must be called before creating any sprites from the texture.
+  ax::Texture2D* acquire(const std::filesystem::path& textureFilePath, const Category category);
+
+  // Decodes the texture on ax::TextureCache's loader thread if it's not resident yet,
+  // so that acquiring it later is a cache hit. Until it's acquired, it isn't used by
+  // any game map, so it's the first to be evicted if it turns out to be unneeded.
+  void prefetch(const std::filesystem::path& textureFilePath, const Category category);
+
+  void beginGameMap(const std::filesystem::path& tmxTiledMapFilePath);
+  void evictUntilWithinBudget();
+
+  size_t getResidentBytes() const;
+  size_t getResidentBytes(const Category category) const;
+  std::vector<std::string> getReport() const;
+
+  inline size_t getBudgetBytes() const { return _budgetBytes; }
+  inline void setBudgetBytes(const size_t budgetBytes) { _budgetBytes = budgetBytes; }
+
+  static inline constexpr size_t kDefaultBudgetBytes = 256 * 1024 * 1024;
+
+ private:
+  struct Entry {
+    Category category{};
+    size_t bytes{};
+    std::filesystem::path plistFilePath;
+    std::vector<std::string> frameNames;
+    std::unordered_set<std::string> gameMaps;
+    uint64_t lastUsedGameMapSeq{};
+    uint64_t lastUsedTick{};
+  };
+
+  TextureManager() = default;
+
+  Entry& addEntry(const std::string& textureFilePath, ax::Texture2D* texture,
+                  const Category category, const std::filesystem::path& plistFilePath);
+  bool isIdle(const std::string& textureFilePath, const Entry& entry) const;
+  void evict(const std::string& textureFilePath, const Entry& entry);
+
+  std::unordered_map<std::string, Entry> _entries;
+  std::unordered_set<std::string> _prefetchingTextures;
+  std::array<size_t, static_cast<size_t>(Category::SIZE)> _residentBytes{};
+  size_t _budgetBytes{kDefaultBudgetBytes};
+  std::string _currentGameMap;
+  uint64_t _gameMapSeq{};
+  uint64_t _tick{};
+  size_t _numEvicted{};
+  size_t _numPrefetched{};
+};
+
+}  // namespace requiem
+
+#endif  // REQUIEM_TEXTURE_MANAGER_H_
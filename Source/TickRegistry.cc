@@ -0,0 +1,89 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#include "TickRegistry.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "FrameClock.h"
+#include "util/StringUtil.h"
+
+using namespace std;
+
+namespace requiem {
+
+namespace {
+
+constexpr array<const char*, static_cast<size_t>(TickRegistry::Phase::SIZE)> kPhaseStr{{
+  "pre-physics",
+  "post-physics",
+  "late",
+}};
+
+// The weight of the latest tick in the moving average of tick times.
+constexpr float kAvgTickTimeWeight = .05f;
+
+}  // namespace
+
+void TickRegistry::add(const string& name,
+                       const Phase phase,
+                       const int priority,
+                       const bool followsRealTime,
+                       TickFn&& tick,
+                       IsActiveFn&& isActive) {
+  auto& subsystems = _subsystems[static_cast<size_t>(phase)];
+  auto it = std::upper_bound(subsystems.begin(), subsystems.end(), priority,
+                             [](const int priority, const Subsystem& s) { return priority < s.priority; });
+
+  Subsystem subsystem;
+  subsystem.name = name;
+  subsystem.priority = priority;
+  subsystem.followsRealTime = followsRealTime;
+  subsystem.tick = std::move(tick);
+  subsystem.isActive = std::move(isActive);
+  subsystems.insert(it, std::move(subsystem));
+}
+
+void TickRegistry::tick(const Phase phase) {
+  using namespace std::chrono;
+
+  const FrameClock& frameClock = FrameClock::the();
+  for (auto& subsystem : _subsystems[static_cast<size_t>(phase)]) {
+    if (subsystem.isActive && !subsystem.isActive()) {
+      subsystem.numSkips++;
+      continue;
+    }
+
+    const auto begin = steady_clock::now();
+    subsystem.tick(subsystem.followsRealTime ? frameClock.getRealDelta() : frameClock.getGameDelta());
+    const float tickTimeUs = duration<float, micro>(steady_clock::now() - begin).count();
+
+    subsystem.avgTickTimeUs = (subsystem.numTicks) ?
+      subsystem.avgTickTimeUs + (tickTimeUs - subsystem.avgTickTimeUs) * kAvgTickTimeWeight : tickTimeUs;
+    subsystem.peakTickTimeUs = std::max(subsystem.peakTickTimeUs, tickTimeUs);
+    subsystem.numTicks++;
+  }
+}
+
+void TickRegistry::clear() {
+  for (auto& subsystems : _subsystems) {
+    subsystems.clear();
+  }
+}
+
+vector<string> TickRegistry::getReport() const {
+  vector<string> report;
+  for (size_t i = 0; i < _subsystems.size(); i++) {
+    for (const auto& subsystem : _subsystems[i]) {
+      const uint64_t numFrames = subsystem.numTicks + subsystem.numSkips;
+      const float idlePercentage = (numFrames) ? 100.0f * subsystem.numSkips / numFrames : 0.0f;
+      report.push_back(string_util::format("[%s] %s: avg %.1f us, peak %.1f us, idle %.0f%%",
+                                           kPhaseStr[i], subsystem.name.c_str(),
+                                           subsystem.avgTickTimeUs, subsystem.peakTickTimeUs,
+                                           idlePercentage));
+    }
+  }
+  return report;
+}
+
+}  // namespace requiem
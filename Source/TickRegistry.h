@@ -0,0 +1,66 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_TICK_REGISTRY_H_
+#define REQUIEM_TICK_REGISTRY_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace requiem {
+
+// The subsystems ticked by GameScene::update(). Within each phase, they're
+// ticked in ascending order of priority, and the ones which report that they
+// have nothing to do are skipped. The time spent in each tick is recorded
+// so that the per-subsystem cost can be printed via the `tickstats` command.
+class TickRegistry final {
+ public:
+  enum class Phase {
+    PRE_PHYSICS,
+    POST_PHYSICS,
+    LATE,
+    SIZE
+  };
+
+  using TickFn = std::function<void (const float delta)>;
+  using IsActiveFn = std::function<bool ()>;
+
+  TickRegistry() = default;
+  TickRegistry(const TickRegistry&) = delete;
+  TickRegistry& operator=(const TickRegistry&) = delete;
+
+  // @param followsRealTime: whether `tick` receives the real delta rather than the
+  //                         game delta, i.e., it keeps its pace in slow motion.
+  // @param isActive: if it returns false, `tick` is skipped in this frame (optional).
+  void add(const std::string& name,
+           const Phase phase,
+           const int priority,
+           const bool followsRealTime,
+           TickFn&& tick,
+           IsActiveFn&& isActive = nullptr);
+  void tick(const Phase phase);
+  void clear();
+
+  std::vector<std::string> getReport() const;
+
+ private:
+  struct Subsystem final {
+    std::string name;
+    int priority{};
+    bool followsRealTime{};
+    TickFn tick;
+    IsActiveFn isActive;
+    float avgTickTimeUs{};
+    float peakTickTimeUs{};
+    uint64_t numTicks{};
+    uint64_t numSkips{};
+  };
+
+  std::array<std::vector<Subsystem>, static_cast<size_t>(Phase::SIZE)> _subsystems;
+};
+
+}  // namespace requiem
+
+#endif  // REQUIEM_TICK_REGISTRY_H_
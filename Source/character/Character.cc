@@ -9,18 +9,20 @@
 #include "Audio.h"
 #include "CallbackManager.h"
 #include "Constants.h"
+#include "FrameClock.h"
+#include "TextureManager.h"
 #include "character/Player.h"
 #include "combat/ComboSystem.h"
 #include "gameplay/ExpPointTable.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
+#include "skill/MagicalMissile.h"
 #include "util/AxUtil.h"
 #include "util/B2BodyBuilder.h"
 #include "util/JsonUtil.h"
 #include "util/Logger.h"
 #include "util/MathUtil.h"
 #include "util/RandUtil.h"
-#include "util/TimeUtil.h"
 
 namespace fs = std::filesystem;
 using namespace std;
@@ -45,6 +47,26 @@ Character::Character(const fs::path& jsonFilePath)
   }
 }
 
+Character::~Character() {
+  // Fallback animations are shared between several slots,
+  // so make sure each animation is only released once.
+  unordered_set<Animation*> animations{_bodyAnimations.begin(), _bodyAnimations.end()};
+  animations.insert(_bodyExtraAttackAnimations.begin(), _bodyExtraAttackAnimations.end());
+  for (const auto& [_, animation] : _skillBodyAnimations) {
+    animations.insert(animation);
+  }
+  animations.erase(nullptr);
+
+  for (auto animation : animations) {
+    animation->release();
+  }
+
+  for (const auto& callbackId : _pendingCallbackIds) {
+    CallbackManager::the().cancel(callbackId);
+  }
+  dropAfterImageFx();
+}
+
 bool Character::showOnMap(float x, float y) {
   if (_isShownOnMap || _isKilled) {
     return false;
@@ -59,6 +81,12 @@ bool Character::removeFromMap() {
     return false;
   }
 
+  _bodyAnimator.setSprite(nullptr);
+
+  // The callback which would disable the afterimages may never run if it's
+  // removed in the middle of a dodge or a skill.
+  dropAfterImageFx();
+
   if (!_isKilled) {
     destroyBody();
   }
@@ -87,6 +115,17 @@ void Character::update(const float delta) {
   _bodySprite->setPosition(b2bodyPos.x * kPpm + _characterProfile.spriteOffsetX,
                            b2bodyPos.y * kPpm + _characterProfile.spriteOffsetY);
 
+  // Only animate the body sprite while it's near the camera.
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  _bodyAnimator.setCulled(!gmMgr->isInCullingRect(_bodySprite->getPosition()));
+
+  // This may complete the KILLED animation and invoke onKilled(),
+  // which may have destroyed the b2body.
+  _bodyAnimator.update(delta);
+  if (_isKilled) {
+    return;
+  }
+
   // Handle stats regeneration.
   _statsRegenTimer += delta;
   if (_statsRegenTimer >= 5.0f) {
@@ -99,14 +138,6 @@ void Character::update(const float delta) {
     hud->updateStatusBars();
   }
 
-  for (const auto interactable : _inRangeInteractables) {
-    if (const auto trigger = dynamic_cast<GameMap::Trigger*>(interactable)) {
-      if (const auto damage = trigger->getDamage()) {
-        receiveDamage(damage);
-      }
-    }
-  }
-
   _comboSystem->update(delta);
 
   if (_isUsingSkill) {
@@ -164,17 +195,15 @@ void Character::import(const fs::path& jsonFilePath) {
 }
 
 void Character::replaceSpritesheet(const fs::path& jsonFilePath) {
-  const float spritesheetZOrder = _bodySpritesheet->getLocalZOrder();
+  const int spritesheetZOrder = _bodySpritesheet->getLocalZOrder();
 
   _bodySprite->removeFromParent();
-  _bodySpritesheet->removeFromParent();
   std::fill(_bodyAnimations.begin(), _bodyAnimations.end(), nullptr);
   std::fill(_bodyExtraAttackAnimations.begin(), _bodyExtraAttackAnimations.end(), nullptr);
 
   _characterProfile.loadSpritesheetInfo(jsonFilePath);
   loadBodyAnimations(_characterProfile.textureResDirPath);
-
-  ax_util::addChildWithParentCameraMask(_node, _bodySpritesheet, spritesheetZOrder);
+  addBodySpriteToSpriteBatch(spritesheetZOrder);
 }
 
 void Character::defineBody(b2BodyType bodyType,
@@ -307,6 +336,9 @@ void Character::defineTexture(const fs::path& bodyTextureResDirPath, float x, fl
 }
 
 void Character::loadBodyAnimations(const fs::path& bodyTextureResDirPath) {
+  TextureManager::the().acquire(getSpritesheetFilePath(bodyTextureResDirPath),
+                                TextureManager::Category::CHARACTER);
+
   createBodyAnimation(State::IDLE, nullptr);
   Animation* fallback = _bodyAnimations[State::IDLE];
 
@@ -357,10 +389,14 @@ void Character::loadBodyAnimations(const fs::path& bodyTextureResDirPath) {
   _bodySprite = Sprite::createWithSpriteFrameName(framePrefix + "_idle/0.png");
   _bodySprite->setScale(_characterProfile.spriteScaleX,
                         _characterProfile.spriteScaleY);
+  _bodyAnimator.setSprite(_bodySprite);
+}
 
-  _bodySpritesheet = SpriteBatchNode::create((bodyTextureResDirPath / "spritesheet.png").native());
-  _bodySpritesheet->getTexture()->setAliasTexParameters();  // disable texture antialiasing
-  _bodySpritesheet->addChild(_bodySprite);
+void Character::addBodySpriteToSpriteBatch(const int zOrder) {
+  // Characters sharing the same spritesheet are drawn by the same batch.
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  _bodySpritesheet = gmMgr->getSpriteBatchManager()->addSprite(
+      _bodySprite, getSpritesheetFilePath(_characterProfile.textureResDirPath), zOrder);
 }
 
 void Character::createBodyAnimation(const Character::State state,
@@ -401,22 +437,15 @@ Animation* Character::getBodyAttackAnimation() const {
 }
 
 void Character::runAnimation(State state, bool loop) {
-  Animate* animate = Animate::create((state != State::ATTACKING) ? _bodyAnimations[state] :
-                                                                   getBodyAttackAnimation());
-  _bodySprite->stopAllActions();
-  _bodySprite->runAction(loop ? dynamic_cast<Action*>(RepeatForever::create(animate)) :
-                                dynamic_cast<Action*>(Repeat::create(animate, 1)));
+  _bodyAnimator.play((state != State::ATTACKING) ? _bodyAnimations[state] : getBodyAttackAnimation(), loop);
 
   if (state == State::ATTACKING) {
     _attackAnimationIdx = (_attackAnimationIdx + 1) % _kAttackAnimationIdxMax;
   }
 }
 
-void Character::runAnimation(State state, const function<void ()>& func) const {
-  auto animate = Animate::create(_bodyAnimations[state]);
-  auto callback = CallFunc::create(func);
-  _bodySprite->stopAllActions();
-  _bodySprite->runAction(Sequence::createWithTwoActions(animate, callback));
+void Character::runAnimation(State state, function<void ()> func) {
+  _bodyAnimator.play(_bodyAnimations[state], std::move(func));
 }
 
 void Character::runAnimation(const string& framesName, float interval) {
@@ -431,8 +460,7 @@ void Character::runAnimation(const string& framesName, float interval) {
     _skillBodyAnimations.insert({framesName, bodyAnimation});
   }
 
-  _bodySprite->stopAllActions();
-  _bodySprite->runAction(Repeat::create(Animate::create(bodyAnimation), 1));
+  _bodyAnimator.play(bodyAnimation, /*loop=*/false);
 }
 
 float Character::getAttackAnimationDuration(const Character::State state) const {
@@ -539,11 +567,23 @@ void Character::onKilled() {
     Audio::the().playSfx(sfxFilePath);
   }
 
-  for (const auto& callback : _onKilledCallbacks) {
+  // The callbacks may remove themselves, e.g., GameMap::endBossFight().
+  const auto onKilledCallbacks = _onKilledCallbacks;
+  for (const auto& [_, callback] : onKilledCallbacks) {
     std::invoke(callback);
   }
 }
 
+uint64_t Character::addOnKilledCallback(function<void ()>&& callback) {
+  const uint64_t callbackId = _nextOnKilledCallbackId++;
+  _onKilledCallbacks.emplace_back(callbackId, std::move(callback));
+  return callbackId;
+}
+
+void Character::removeOnKilledCallback(const uint64_t callbackId) {
+  _onKilledCallbacks.remove_if([callbackId](const auto& entry) { return entry.first == callbackId; });
+}
+
 void Character::onFallToGroundOrPlatform() {
   if (_body->GetLinearVelocity().y < -4.5f) {
     getUpFromFalling();
@@ -567,8 +607,8 @@ void Character::onBodyContactWithEnemyBody(Character* enemy) {
 
   const float knockBackForceX = _isFacingRight ? -2.5f : 2.5f;
   const float knockBackForceY = 3.0f;
-  enemy->knockBack(this, knockBackForceX, knockBackForceY);
-  enemy->inflictDamage(this, 25);
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  gmMgr->getDamageQueue()->push({enemy, this, 25, {knockBackForceX, knockBackForceY}});
 }
 
 void Character::onMeleeWeaponContactWithEnemyBody(Character* enemy) {
@@ -602,7 +642,7 @@ bool Character::isSkillActivationDisallowed() const {
 void Character::startRunning() {
   /*
   _isStartRunning = true;
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     _isStartRunning = false;
   }, _bodyAnimations[State::RUNNING_START]->getDuration());
   */
@@ -610,7 +650,7 @@ void Character::startRunning() {
 
 void Character::stopRunning() {
   _isStopRunning = true;
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     _isStopRunning = false;
   }, _bodyAnimations[State::RUNNING_STOP]->getDuration());
 }
@@ -632,7 +672,7 @@ void Character::moveImpl(const bool moveTowardsRight) {
 
   _isFacingRight = moveTowardsRight;
   _isTryingToMove = true;
-  _lastMoveTimeMs = time_util::getCurrentTimeMs();
+  _lastMoveTimeMs = FrameClock::the().getGameTimeMs();
 
   const b2Vec2& velocity = _body->GetLinearVelocity();
   if (velocity.x == 0 && _previousBodyVelocity.x == 0) {
@@ -689,7 +729,7 @@ void Character::avoidSlidingDownSlope() {
 }
 
 bool Character::isTryingToMoveRecently(const float gracePeriod) const {
-  return _isTryingToMove || (time_util::getCurrentTimeMs() - _lastMoveTimeMs) < gracePeriod;
+  return _isTryingToMove || (FrameClock::the().getGameTimeMs() - _lastMoveTimeMs) < gracePeriod;
 }
 
 void Character::jump() {
@@ -713,13 +753,13 @@ void Character::jump() {
   }
 
   _isJumpingDisallowed = true;
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     _isJumpingDisallowed = false;
   }, .2f);
 
   _isJumping = true;
   _isTryingToMove = true;
-  _lastMoveTimeMs = time_util::getCurrentTimeMs();
+  _lastMoveTimeMs = FrameClock::the().getGameTimeMs();
 
   // Respect the temporary linear damping set by dodging.
   if (!isDodging()) {
@@ -731,7 +771,7 @@ void Character::jump() {
 void Character::doubleJump() {
   jump();
 
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     jump();
   }, .25f);
 }
@@ -742,7 +782,7 @@ void Character::jumpDown() {
   }
 
   _fixtures[FixtureType::FEET]->SetSensor(true);
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     _fixtures[FixtureType::FEET]->SetSensor(false);
   }, .25f);
 }
@@ -781,7 +821,7 @@ void Character::getUpFromFalling() {
   }
 
   _isGettingUpFromFalling = true;
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     _isGettingUpFromFalling = false;
   }, _bodyAnimations[State::FALLING_GETUP]->getDuration());
 }
@@ -809,14 +849,14 @@ void Character::dodgeImpl(const Character::State dodgeState, const float rushPow
   enableAfterImageFx(AfterImageFxManager::kPlayerAfterImageColor);
 
   _isInvincible = true;
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     _isInvincible = false;
   }, 0.2f);
 
   _hasDodgedMidair = true;
 
   isDodgingFlag = true;
-  CallbackManager::the().runAfter([this, &isDodgingFlag](const CallbackManager::CallbackId) {
+  runAfter([this, &isDodgingFlag](const CallbackManager::CallbackId) {
     isDodgingFlag = false;
     _body->SetLinearDamping(0);
     disableAfterImageFx();
@@ -839,17 +879,25 @@ void Character::teleportToTarget(const b2Vec2& targetPos) {
 
 void Character::enableAfterImageFx(const ax::Color3B& color) {
   auto afterImageFxMgr = SceneManager::the().getCurrentScene<GameScene>()->getAfterImageFxManager();
-  afterImageFxMgr->registerNode(_node, color, 0.15f, 0.05f);
+  afterImageFxMgr->registerActor(this, color, 0.15f, 0.05f);
 }
 
 void Character::disableAfterImageFx() {
   auto afterImageFxMgr = SceneManager::the().getCurrentScene<GameScene>()->getAfterImageFxManager();
-  afterImageFxMgr->unregisterNode(_node);
+  afterImageFxMgr->unregisterActor(this);
+}
+
+void Character::dropAfterImageFx() {
+  // The GameScene may be tearing down already.
+  auto gameScene = SceneManager::the().getCurrentScene<GameScene>();
+  if (auto afterImageFxMgr = gameScene ? gameScene->getAfterImageFxManager() : nullptr) {
+    afterImageFxMgr->dropActor(this);
+  }
 }
 
 void Character::runIntroAnimation() {
   _isRunningIntroAnimation = true;
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     _isRunningIntroAnimation = false;
   }, _bodyAnimations[State::INTRO]->getDuration());
 
@@ -876,15 +924,12 @@ bool Character::attack(const Character::State attackState,
     _overridingAttackState = attackState;
   }
 
-  {
-    lock_guard<mutex> lock{_cancelAttackCallbackIDsMutex};
-    const CallbackManager::CallbackId cancelAttackCallbackId = CallbackManager::the().runAfter([this](const CallbackManager::CallbackId id) {
-      _isAttacking = false;
-      _overridingAttackState = std::nullopt;
-      _cancelAttackCallbackIDs.erase(id);
-    }, getAttackAnimationDuration(attackState));
-    _cancelAttackCallbackIDs.emplace(cancelAttackCallbackId);
-  }
+  const CallbackManager::CallbackId cancelAttackCallbackId = runAfter([this](const CallbackManager::CallbackId id) {
+    _isAttacking = false;
+    _overridingAttackState = std::nullopt;
+    _cancelAttackCallbackIDs.erase(id);
+  }, getAttackAnimationDuration(attackState));
+  _cancelAttackCallbackIDs.emplace(cancelAttackCallbackId);
 
   const auto weapon = _equipmentSlots[Equipment::Type::WEAPON];
   if (!weapon) {
@@ -920,21 +965,32 @@ void Character::cancelAttack() {
   _isAttacking = false;
   _overridingAttackState = std::nullopt;
 
-  {
-    lock_guard<mutex> lock{_cancelAttackCallbackIDsMutex};
-    for (const auto& callbackId : _cancelAttackCallbackIDs) {
-      CallbackManager::the().cancel(callbackId);
-    }
-    _cancelAttackCallbackIDs.clear();
+  for (const auto& callbackId : _cancelAttackCallbackIDs) {
+    CallbackManager::the().cancel(callbackId);
+    _pendingCallbackIds.erase(callbackId);
   }
+  _cancelAttackCallbackIDs.clear();
 
-  {
-    lock_guard<mutex> lock{_inflictDamageCallbackIDsMutex};
-    for (const auto& callbackId : _inflictDamageCallbackIDs) {
-      CallbackManager::the().cancel(callbackId);
-    }
-    _inflictDamageCallbackIDs.clear();
+  for (const auto& callbackId : _inflictDamageCallbackIDs) {
+    CallbackManager::the().cancel(callbackId);
+    _pendingCallbackIds.erase(callbackId);
   }
+  _inflictDamageCallbackIDs.clear();
+}
+
+CallbackManager::CallbackId Character::runAfter(function<void (const CallbackManager::CallbackId)>&& callback,
+                                                const float delay) {
+  const CallbackManager::CallbackId callbackId = CallbackManager::the().runAfter(
+      [this, callback = std::move(callback)](const CallbackManager::CallbackId id) {
+    _pendingCallbackIds.erase(id);
+    callback(id);
+  }, delay);
+
+  // Without any delay, the callback has already run by now.
+  if (delay != 0) {
+    _pendingCallbackIds.emplace(callbackId);
+  }
+  return callbackId;
 }
 
 bool Character::activateSkill(Skill* rawSkill) {
@@ -968,7 +1024,7 @@ bool Character::activateSkill(Skill* rawSkill) {
   _isUsingSkill = true;
   _currentlyUsedSkill = rawSkill;
 
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     _isUsingSkill = false;
     _currentState = State::FORCE_UPDATE;
   }, skill->getSkillProfile().framesDuration);
@@ -981,7 +1037,15 @@ bool Character::activateSkill(Skill* rawSkill) {
   }
 
   if (skill->getSkillProfile().shouldForkInstance) {
-    skill = Skill::create(skill->getSkillProfile().jsonFilePath, this);
+    if (dynamic_cast<MagicalMissile*>(rawSkill)) {
+      auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+      skill = gmMgr->getProjectilePool()->acquire(skill->getSkillProfile().jsonFilePath, this);
+    } else {
+      skill = Skill::create(skill->getSkillProfile().jsonFilePath, this);
+    }
+    if (!skill) {
+      return false;
+    }
   }
   _activeSkillInstances.emplace(skill);
   skill->activate();
@@ -1035,27 +1099,25 @@ bool Character::inflictDamage(Character* target, int damage,
   }
 
   for (int i = 0; i < numTimesInflictDamage; i++) {
-    const CallbackManager::CallbackId id = CallbackManager::the().runAfter([this, target, damage](const CallbackManager::CallbackId id) {
+    const CallbackManager::CallbackId id = runAfter([this, target, damage](const CallbackManager::CallbackId id) {
+      _inflictDamageCallbackIDs.erase(id);
+
       if (_isTakingDamage || !_inRangeTargets.contains(target)) {
         return;
       }
 
-      inflictDamage(target, damage);
-
+      // The damage and knockback are applied when the DamageQueue is resolved.
       const float attackForce = _characterProfile.attackForce;
       const float knockBackForceX = _isFacingRight ? attackForce : -attackForce;
       const float knockBackForceY = attackForce;
-      knockBack(target, knockBackForceX, knockBackForceY);
+      auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+      gmMgr->getDamageQueue()->push({this, target, damage, {knockBackForceX, knockBackForceY}});
 
       if (const auto weapon = _equipmentSlots[Equipment::Type::WEAPON]) {
         Audio::the().playSfx(weapon->getSfxFilePath(Equipment::Sfx::SFX_HIT));
       }
-
-      lock_guard<mutex> lock{_inflictDamageCallbackIDsMutex};
-      _inflictDamageCallbackIDs.erase(id);
     }, _characterProfile.attackDelay + damageInflictionInterval * i);
 
-    lock_guard<mutex> lock{_inflictDamageCallbackIDsMutex};
     _inflictDamageCallbackIDs.emplace(id);
   }
 
@@ -1073,7 +1135,7 @@ bool Character::receiveDamage(Character* source, int damage, float takeDamageDur
 
   if (_isBlocking) {
     _isHitWhileBlocking = true;
-    CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+    runAfter([this](const CallbackManager::CallbackId) {
       _isHitWhileBlocking = false;
     }, _bodyAnimations[State::BLOCKING_HIT]->getDuration());
     return true;
@@ -1084,7 +1146,7 @@ bool Character::receiveDamage(Character* source, int damage, float takeDamageDur
   _isTakingDamageFromTraps = !source;
   if (source) {
     _isTakingDamage = true;
-    CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+    runAfter([this](const CallbackManager::CallbackId) {
       _isTakingDamage = false;
       _isTakingDamageFromTraps = false;
     }, takeDamageDuration);
@@ -1106,7 +1168,7 @@ bool Character::receiveDamage(Character* source, int damage, float takeDamageDur
       }
 
       for (const auto ally : getAllies()) {
-        if (ally->isKilled() || ally->isSetToKill()) {
+        if (ally->isKilled() || ally->isSetToKill() || !source->isHostile(ally)) {
           continue;
         }
         source->setLockedOnTarget(ally);
@@ -1146,6 +1208,10 @@ bool Character::receiveDamage(int damage) {
 }
 
 void Character::lockOn(Character* target) {
+  if (target && !isHostile(target)) {
+    return;
+  }
+
   _isAlerted = true;
   setLockedOnTarget(target);
 }
@@ -1426,21 +1492,11 @@ bool Character::isWaitingForPartyLeader() const {
   return _party && _party->getWaitingMemberLocationInfo(_characterProfile.jsonFilePath);
 }
 
-unordered_set<Character*> Character::getAllies() const {
+AllyView Character::getAllies() const {
   if (!_party) {
     return {};
   }
-
-  unordered_set<Character*> ret;
-  for (const auto& member : _party->getMembers()) {
-    if (member.get() != this) {
-      ret.insert(member.get());
-    }
-  }
-  if (Character* leader = _party->getLeader(); leader != this) {
-    ret.insert(leader);
-  }
-  return ret;
+  return AllyView{_party->getLeaderAndMembers(), this};
 }
 
 int Character::getDamageOutput() const {
@@ -1449,7 +1505,7 @@ int Character::getDamageOutput() const {
   if (Equipment* weapon = _equipmentSlots[Equipment::Type::WEAPON]) {
     output += weapon->getEquipmentProfile().bonusPhysicalDamage;
   }
-  return output + rand_util::randInt(-5, 5); // temporary
+  return output + rand_util::randInt(rand_util::Stream::COMBAT, -5, 5); // temporary
 }
 
 void Character::regenHealth(int deltaHealth) {
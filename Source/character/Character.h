@@ -7,7 +7,6 @@
 #include <functional>
 #include <list>
 #include <memory>
-#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -21,6 +20,8 @@
 #include "DynamicActor.h"
 #include "Importable.h"
 #include "Interactable.h"
+#include "SpriteAnimator.h"
+#include "character/Faction.h"
 #include "character/Party.h"
 #include "item/Item.h"
 #include "item/Equipment.h"
@@ -140,7 +141,7 @@ class Character : public DynamicActor, public Importable {
     FIXTURE_SIZE
   };
 
-  virtual ~Character() override = default;
+  virtual ~Character() override;
 
   virtual bool showOnMap(float x, float y) override;  // DynamicActor
   virtual bool removeFromMap() override;  // DynamicActor
@@ -248,9 +249,18 @@ class Character : public DynamicActor, public Importable {
   inline float getGroundAngle() const { return _groundAngle; }
   inline void setGroundAngle(float groundAngle) { _groundAngle = groundAngle; }
 
-  inline void addOnKilledCallback(std::function<void ()>&& callback) { _onKilledCallbacks.emplace_back(std::move(callback)); }
+  // @return: the id which removeOnKilledCallback() takes.
+  uint64_t addOnKilledCallback(std::function<void ()>&& callback);
+  void removeOnKilledCallback(const uint64_t callbackId);
+
+  // Runs the callback via CallbackManager, and cancels it if this character is destroyed first.
+  // All the delayed callbacks which capture this character should be scheduled through here.
+  CallbackManager::CallbackId runAfter(std::function<void (const CallbackManager::CallbackId id)>&& callback,
+                                       const float delay);
+  inline bool hasPendingCallbacks() const { return !_pendingCallbackIds.empty(); }
 
   inline void resetAttackAnimationIdx() { _attackAnimationIdx = 0; }
+  inline SpriteAnimator& getBodyAnimator() { return _bodyAnimator; }
 
   inline Character::Profile& getCharacterProfile() { return _characterProfile; }
 
@@ -280,9 +290,15 @@ class Character : public DynamicActor, public Importable {
   void removeActiveSkillInstance(Skill* skill);
 
   bool isWaitingForPartyLeader() const;
-  std::unordered_set<Character*> getAllies() const;
-  inline std::shared_ptr<Party> getParty() const { return _party; }
+  AllyView getAllies() const;
+  inline const std::shared_ptr<Party>& getParty() const { return _party; }
   inline void setParty(std::shared_ptr<Party> party) { _party = party; }
+  inline Party::TeamId getTeamId() const { return _party ? _party->getTeamId() : Party::kNoTeam; }
+  inline bool isAlly(const Character* other) const {
+    return other != this && getTeamId() != Party::kNoTeam && getTeamId() == other->getTeamId();
+  }
+  inline bool isHostile(const Character* other) const { return faction::isHostile(_factionId, other->_factionId); }
+  inline faction::FactionId getFactionId() const { return _factionId; }
 
   int getDamageOutput() const;
   inline float getAnimationDuration(const Character::State state) const {
@@ -361,6 +377,7 @@ class Character : public DynamicActor, public Importable {
   virtual void redefineWeaponFixture(short weaponMaskBits = 0);
   virtual void defineTexture(const std::filesystem::path& bodyTextureResDirPath, float x, float y);
   virtual void loadBodyAnimations(const std::filesystem::path& bodyTextureResDirPath);
+  void addBodySpriteToSpriteBatch(const int zOrder);
 
   void moveImpl(const bool moveTowardsRight);
   void clampLinearVelocity();
@@ -371,6 +388,7 @@ class Character : public DynamicActor, public Importable {
 
   bool receiveDamage(Character* source, int damage, float numSecCantMove);
   void cancelAttack();
+  void dropAfterImageFx();
 
   void createBodyAnimation(const Character::State state,
                            ax::Animation* fallbackAnimation);
@@ -382,7 +400,7 @@ class Character : public DynamicActor, public Importable {
   }
 
   void runAnimation(Character::State state, bool loop=true);
-  void runAnimation(Character::State state, const std::function<void ()>& func) const;
+  void runAnimation(Character::State state, std::function<void ()> func);
   void runAnimation(const std::string& framesName, float interval);
 
   float getAttackAnimationDuration(const Character::State state) const;
@@ -449,12 +467,12 @@ class Character : public DynamicActor, public Importable {
   float _groundAngle{};
 
   // Callbacks
-  mutable std::mutex _cancelAttackCallbackIDsMutex;
-  mutable std::mutex _inflictDamageCallbackIDsMutex;
   std::unordered_set<CallbackManager::CallbackId> _cancelAttackCallbackIDs;
   std::unordered_set<CallbackManager::CallbackId> _inflictDamageCallbackIDs;
+  std::unordered_set<CallbackManager::CallbackId> _pendingCallbackIds;
 
-  std::list<std::function<void ()>> _onKilledCallbacks;
+  std::list<std::pair<uint64_t, std::function<void ()>>> _onKilledCallbacks;
+  uint64_t _nextOnKilledCallbackId{1};
 
   // Combat related systems
   std::shared_ptr<ComboSystem> _comboSystem;
@@ -495,6 +513,7 @@ class Character : public DynamicActor, public Importable {
   const int _kAttackAnimationIdxMax;
   int _attackAnimationIdx{};
   std::vector<ax::Animation*> _bodyExtraAttackAnimations;
+  SpriteAnimator _bodyAnimator;
 
   // Skill animations
   std::unordered_map<std::string, ax::Animation*> _skillBodyAnimations;
@@ -504,6 +523,7 @@ class Character : public DynamicActor, public Importable {
   // (1) be a leader who has a set of allies/followers, or
   // (2) be a follower of other character
   std::shared_ptr<Party> _party;
+  faction::FactionId _factionId{faction::kEnemy};
 };
 
 }  // namespace requiem
@@ -0,0 +1,36 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_CHARACTER_FACTION_H_
+#define REQUIEM_CHARACTER_FACTION_H_
+
+#include <array>
+#include <cstdint>
+
+namespace requiem::faction {
+
+using FactionId = uint8_t;
+using FactionMask = uint8_t;
+
+inline constexpr FactionId kPlayer = 0;
+inline constexpr FactionId kAlly = 1;
+inline constexpr FactionId kEnemy = 2;
+inline constexpr FactionId kSize = 3;
+
+inline constexpr FactionMask toMask(const FactionId factionId) {
+  return static_cast<FactionMask>(1 << factionId);
+}
+
+// kHostileFactionMasks[i] contains the factions which faction `i` is hostile towards.
+inline constexpr std::array<FactionMask, kSize> kHostileFactionMasks{{
+  toMask(kEnemy),                   // kPlayer
+  toMask(kEnemy),                   // kAlly
+  toMask(kPlayer) | toMask(kAlly),  // kEnemy
+}};
+
+inline constexpr bool isHostile(const FactionId a, const FactionId b) {
+  return kHostileFactionMasks[a] & toMask(b);
+}
+
+}  // namespace requiem::faction
+
+#endif  // REQUIEM_CHARACTER_FACTION_H_
@@ -59,6 +59,7 @@ Npc::Npc(const fs::path& jsonFilePath)
   if (_npcProfile.shouldSandbox) {
     _npcController.setSandboxing(_npcProfile.shouldSandbox);
   }
+  _factionId = (_disposition == Npc::Disposition::ALLY) ? faction::kAlly : faction::kEnemy;
 }
 
 void Npc::update(const float delta) {
@@ -70,14 +71,6 @@ void Npc::update(const float delta) {
 
   const b2Vec2& b2bodyPos = _body->GetPosition();
 
-  // Sync the floating health bar with Npc's b2body if it exists.
-  if (_floatingHealthBar->isVisible()) {
-    const float floatingHealthBarX = b2bodyPos.x * kPpm - _floatingHealthBar->getMaxLength() / 2;
-    const float floatingHealthBarY = b2bodyPos.y * kPpm + _characterProfile.bodyHeight / 2 + 10.0f;
-    _floatingHealthBar->setPosition({floatingHealthBarX, floatingHealthBarY});
-    _floatingHealthBar->update(delta);
-  }
-
   // Sync the hint bubble fx sprite with Npc's b2body if it exists.
   if (_hintBubbleFxSprite) {
     const float hintBubbleX = b2bodyPos.x * kPpm;
@@ -112,12 +105,8 @@ bool Npc::showOnMap(float x, float y) {
   // Load sprites, spritesheets, and animations, and then add them to GameMapManager layer.
   defineTexture(_characterProfile.textureResDirPath, x, y);
 
-  _floatingHealthBar = make_unique<StatusBar>(kBarLeftPadding, kBarRightPadding, kHealthBar, 45.0f, 5.0f);
-  _floatingHealthBar->setVisible(false);
-
   _node->removeAllChildren();
-  _node->addChild(_bodySpritesheet, z_order::kNpcBody);
-  _node->addChild(_floatingHealthBar->getLayout(), z_order::kHud);
+  addBodySpriteToSpriteBatch(z_order::kNpcBody);
 
   auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
   ax_util::addChildWithParentCameraMask(gmMgr->getLayer(), _node, z_order::kNpcBody);
@@ -131,7 +120,8 @@ bool Npc::removeFromMap() {
   }
 
   hideHintUI();
-  _floatingHealthBar->getLayout()->removeFromParentAndCleanup(true);
+  SceneManager::the().getCurrentScene<GameScene>()->getFloatingHealthBars()->hide(this);
+  return true;
 }
 
 void Npc::defineBody(b2BodyType bodyType, float x, float y,
@@ -183,7 +173,7 @@ void Npc::onSetToKill() {
 void Npc::onKilled() {
   Character::onKilled();
 
-  _floatingHealthBar->setVisible(false);
+  SceneManager::the().getCurrentScene<GameScene>()->getFloatingHealthBars()->hide(this);
 }
 
 void Npc::beforeMapChanged() {
@@ -224,10 +214,11 @@ bool Npc::receiveDamage(Character* source, int damage) {
   }
 
   _isAlerted = true;
+  _npcController.wakeUp();
 
   if (!source) {
     _isInvincible = true;
-    CallbackManager::the().runAfter([this](const CallbackManager::CallbackId){
+    runAfter([this](const CallbackManager::CallbackId){
       _isInvincible = false;
     }, 1.0f);
   }
@@ -236,8 +227,7 @@ bool Npc::receiveDamage(Character* source, int damage) {
     source->addExp(_characterProfile.exp);
   }
 
-  _floatingHealthBar->setVisible(true);
-  _floatingHealthBar->update(_characterProfile.health, _characterProfile.fullHealth);
+  SceneManager::the().getCurrentScene<GameScene>()->getFloatingHealthBars()->show(this);
 
   return true;
 }
@@ -327,6 +317,7 @@ void Npc::enable() {
     return;
   }
   _node->setVisible(true);
+  _bodySprite->setVisible(true);
   _body->SetEnabled(true);
   _isEnabled = true;
 }
@@ -336,6 +327,7 @@ void Npc::disable() {
     return;
   }
   _node->setVisible(false);
+  _bodySprite->setVisible(false);
   _body->SetEnabled(false);
   _isEnabled = false;
 }
@@ -343,16 +335,16 @@ void Npc::disable() {
 void Npc::dropItems() {
   // We'll use a callback to drop items since creating fixtures during collision callback
   // will cause the game to crash. Ref: https://github.com/libgdx/libgdx/issues/2730
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
 
     for (const auto& i : _npcProfile.droppedItems) {
       const fs::path& itemJsonFilePath = i.first;
       const float dropChance = i.second.chance;
 
-      const float randChance = rand_util::randInt(0, 100);
+      const float randChance = rand_util::randInt(rand_util::Stream::LOOT, 0, 100);
       if (randChance <= dropChance) {
-        int amount = rand_util::randInt(i.second.minAmount, i.second.maxAmount);
+        int amount = rand_util::randInt(rand_util::Stream::LOOT, i.second.minAmount, i.second.maxAmount);
         gmMgr->getGameMap()->createItem(itemJsonFilePath, _killedPos.x * kPpm, _killedPos.y * kPpm, amount);
       }
     }
@@ -428,7 +420,7 @@ void Npc::beginTrade() {
 }
 
 bool Npc::isPlayerLeaderOfParty() const {
-  return _party ? dynamic_cast<Player*>(_party->getLeader()) != nullptr : false;
+  return _party ? _party->getLeader()->getFactionId() == faction::kPlayer : false;
 }
 
 bool Npc::isWaitingForPlayer() const {
@@ -450,6 +442,7 @@ bool Npc::isWaitingForPartyLeader() const {
 
 void Npc::setDisposition(Npc::Disposition disposition) {
   _disposition = disposition;
+  _factionId = (disposition == Npc::Disposition::ALLY) ? faction::kAlly : faction::kEnemy;
 
   switch (disposition) {
     case Npc::Disposition::ALLY:
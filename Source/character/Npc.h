@@ -12,7 +12,6 @@
 #include "character/Character.h"
 #include "character/NpcController.h"
 #include "gameplay/DialogueTree.h"
-#include "ui/hud/StatusBar.h"
 
 namespace requiem {
 
@@ -107,6 +106,16 @@ class Npc final : public Character, public Interactable {
   inline void setShowDuringDay(const bool showDuringDay) { _shouldShowDuringDay = showDuringDay; }
   inline void setShowDuringDusk(const bool showDuringDusk) { _shouldShowDuringDusk = showDuringDusk; }
   inline void setShowDuringNight(const bool showDuringNight) { _shouldShowDuringNight = showDuringNight; }
+  inline bool shouldShowDuringDawn() const { return _shouldShowDuringDawn; }
+  inline bool shouldShowDuringDay() const { return _shouldShowDuringDay; }
+  inline bool shouldShowDuringDusk() const { return _shouldShowDuringDusk; }
+  inline bool shouldShowDuringNight() const { return _shouldShowDuringNight; }
+
+  // Identifies the same npc across being swept into a snapshot by WorldStreamer
+  // and re-created from it, which makes a new Npc object each time.
+  inline uint32_t getInstanceId() const { return _instanceId; }
+  inline void setInstanceId(const uint32_t instanceId) { _instanceId = instanceId; }
+  static inline uint32_t allocateInstanceId() { return _nextInstanceId++; }
 
  private:
   virtual void defineBody(b2BodyType bodyType,
@@ -133,7 +142,9 @@ class Npc final : public Character, public Interactable {
   bool _shouldShowDuringNight;
 
   ax::Sprite* _hintBubbleFxSprite{};
-  std::unique_ptr<StatusBar> _floatingHealthBar;
+
+  static inline uint32_t _nextInstanceId{1};
+  uint32_t _instanceId{allocateInstanceId()};
 };
 
 }  // namespace requiem
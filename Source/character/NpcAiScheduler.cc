@@ -0,0 +1,56 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#include "NpcAiScheduler.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "character/NpcController.h"
+
+using namespace std;
+
+namespace requiem {
+
+namespace {
+
+int getNumWorkers(const int maxNumWorkers) {
+  // Leave one hardware thread to the main thread, which also runs the jobs.
+  const int numHardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+  return std::clamp(numHardwareThreads - 1, 0, maxNumWorkers);
+}
+
+}  // namespace
+
+NpcAiScheduler::NpcAiScheduler() : _workerPool{getNumWorkers(kMaxNumWorkers)} {}
+
+void NpcAiScheduler::update() {
+  if (_npcControllers.empty()) {
+    return;
+  }
+
+  const int numNpcs = static_cast<int>(_npcControllers.size());
+  if (numNpcs < kMinNumNpcsToParallelize) {
+    for (auto npcController : _npcControllers) {
+      npcController->decide();
+    }
+  } else {
+    _workerPool.parallelFor(numNpcs, [this](const int i) {
+      _npcControllers[i]->decide();
+    });
+  }
+
+  for (auto npcController : _npcControllers) {
+    npcController->applyIntent();
+  }
+  _npcControllers.clear();
+}
+
+void NpcAiScheduler::enqueue(NpcController* npcController) {
+  _npcControllers.push_back(npcController);
+}
+
+void NpcAiScheduler::clear() {
+  _npcControllers.clear();
+}
+
+}  // namespace requiem
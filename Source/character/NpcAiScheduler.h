@@ -0,0 +1,38 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_CHARACTER_NPC_AI_SCHEDULER_H_
+#define REQUIEM_CHARACTER_NPC_AI_SCHEDULER_H_
+
+#include <vector>
+
+#include "util/WorkerPool.h"
+
+namespace requiem {
+
+class NpcController;
+
+// Collects the Npcs which are going to think in this frame, runs their
+// decisions in parallel on a fixed worker pool, and then applies their
+// intents on the main thread in the order that they were enqueued.
+class NpcAiScheduler final {
+ public:
+  NpcAiScheduler();
+  NpcAiScheduler(const NpcAiScheduler&) = delete;
+  NpcAiScheduler& operator=(const NpcAiScheduler&) = delete;
+
+  void update();
+  void enqueue(NpcController* npcController);
+  void clear();
+
+ private:
+  static inline constexpr int kMaxNumWorkers = 4;
+  // Below this number of Npcs, waking up the workers costs more than it saves.
+  static inline constexpr int kMinNumNpcsToParallelize = 8;
+
+  WorkerPool _workerPool;
+  std::vector<NpcController*> _npcControllers;
+};
+
+}  // namespace requiem
+
+#endif  // REQUIEM_CHARACTER_NPC_AI_SCHEDULER_H_
@@ -4,6 +4,8 @@
 
 #include "Constants.h"
 #include "character/Npc.h"
+#include "character/NpcAiScheduler.h"
+#include "character/Player.h"
 #include "combat/CombatMotion.h"
 #include "combat/ComboSystem.h"
 #include "scene/GameScene.h"
@@ -22,12 +24,57 @@ constexpr float kAllyFollowDist = .75f;
 constexpr float kMoveDestFollowDist = .2f;
 constexpr float kJumpCheckInterval = .5f;
 constexpr float kActivateRandomSkillInterval = 3.0f;
+constexpr int kSandboxMinMoveDuration = 0;
+constexpr int kSandboxMaxMoveDuration = 5;
+constexpr int kSandboxMinWaitDuration = 0;
+constexpr int kSandboxMaxWaitDuration = 5;
+constexpr float kNearLodDistToViewport = 1.0f;
+constexpr float kMidLodDistToViewport = 8.0f;
 
 }  // namespace
 
 NpcController::NpcController(Npc& npc)
     : _npc{npc},
-      _pathFinder{std::make_unique<AStarPathFinder>()} {}
+      _pathFinder{std::make_unique<AStarPathFinder>()},
+      _lodBucket{_nextLodBucket++} {}
+
+void NpcController::update(const float delta) {
+  drawDebugInfo();
+
+  _lodTimer += delta;
+  _wakeUpTimer = std::max(0.0f, _wakeUpTimer - delta);
+  _lod = determineLod();
+
+  const unsigned int frameIdx = Director::getInstance()->getTotalFrames() + _lodBucket;
+  switch (_lod) {
+    case Lod::NEAR:
+      break;
+    case Lod::MID:
+      if (frameIdx % kMidLodFrameInterval) {
+        replayMoveIntent();
+        return;
+      }
+      break;
+    case Lod::FAR:
+      if (!_isSandboxing) {
+        _moveIntent = MoveIntent::NONE;
+        _lodTimer = 0;
+        return;
+      }
+      if (frameIdx % kFarLodFrameInterval) {
+        replayMoveIntent();
+        return;
+      }
+      break;
+  }
+
+  // Think with all the time elapsed since the last time this Npc thought.
+  perceive(_lodTimer);
+  _lodTimer = 0;
+
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  gmMgr->getNpcAiScheduler()->enqueue(this);
+}
 
 // This Npc may perform one of the following actions:
 // (1) Has `_lockedOnTarget` and `_lockedOnTarget` is not dead yet:
@@ -40,36 +87,29 @@ NpcController::NpcController(Npc& npc)
 // (4) Has a target destination (_moveDest) to travel to
 // (5) Is following another Character -> moveToTarget()
 // (6) Sandboxing (just moving around wasting its time) -> moveRandomly()
-void NpcController::update(const float delta) {
-  if (_npc.isKilled() || _npc.isSetToKill() || _npc.isAttacking()) {
+//
+// This may run on a worker thread, so it must only read `_perception`
+// and write to this controller's own states.
+void NpcController::decide() {
+  _intent = Intent{};
+
+  const Perception& perception = _perception;
+  if (!perception.canAct) {
     return;
   }
 
-  Character* lockedOnTarget = _npc.getLockedOnTarget();
-  if (lockedOnTarget && !lockedOnTarget->isSetToKill()) {
-    auto& skillbook = _npc.getSkillBook()[Skill::Type::MAGIC];
-    if (skillbook.size() && _activateSkillTimer >= kActivateRandomSkillInterval) {
-      Skill* skill = skillbook.front();
-      _npc.activateSkill(skill);
+  if (perception.lockedOnTarget && !perception.isLockedOnTargetSetToKill) {
+    if (perception.hasMagicSkill && _activateSkillTimer >= kActivateRandomSkillInterval) {
+      _intent.action = Intent::Action::ACTIVATE_SKILL;
       _activateSkillTimer = 0;
-    } else if (_npc.getInRangeTargets().contains(lockedOnTarget)) {
-      const optional<Character::State> attackState = _npc.getCombatSystem().determineNextAttackState();
-      if (!attackState.has_value()) {
-        _npc.attack();
-        return;
-      }
-      if (!handleCombatMotion(_npc, *attackState)) {
-        VGLOG(LOG_ERR, "Failed to handle combat motion, character: [%s], attackState: [%d]",
-              _npc.getCharacterProfile().jsonFilePath.c_str(), *attackState);
-      }
-    } else if (!_npc.isUsingSkill()) {
-      moveToTarget(delta, lockedOnTarget, _npc.getCharacterProfile().attackRange / kPpm);
+    } else if (perception.isLockedOnTargetInRange) {
+      _intent.action = Intent::Action::ATTACK;
+    } else if (!perception.isUsingSkill && perception.lockedOnTargetPos.has_value()) {
+      moveToTarget(perception.delta, *perception.lockedOnTargetPos, perception.attackRange);
     }
-    _activateSkillTimer += delta;
-  } else if (lockedOnTarget && lockedOnTarget->isSetToKill()) {
-    Character* killedTarget = lockedOnTarget;
-    _npc.setLockedOnTarget(nullptr);
-    findNewLockedOnTargetFromParty(killedTarget);
+    _activateSkillTimer += perception.delta;
+  } else if (perception.lockedOnTarget && perception.isLockedOnTargetSetToKill) {
+    _intent.action = Intent::Action::FIND_NEW_LOCKED_ON_TARGET;
   /*
   } else if (_npc.getParty() &&
              !_npc.isWaitingForPartyLeader() &&
@@ -79,11 +119,63 @@ void NpcController::update(const float delta) {
     _npc.getBody()->SetAwake(true);
   */
   } else if (_moveDest.x || _moveDest.y) {
-    moveToTarget(delta, _moveDest, kMoveDestFollowDist);
-  } else if (_npc.getParty() && !_npc.isWaitingForPartyLeader()) {
-    moveToTarget(delta, _npc.getParty()->getLeader(), kAllyFollowDist);
+    moveToTarget(perception.delta, _moveDest, kMoveDestFollowDist);
+  } else if (perception.shouldFollowPartyLeader && perception.partyLeaderPos.has_value()) {
+    moveToTarget(perception.delta, *perception.partyLeaderPos, kAllyFollowDist);
   } else if (_isSandboxing) {
-    moveRandomly(delta, 0, 5, 0, 5);
+    moveRandomly(perception.delta);
+  }
+}
+
+void NpcController::applyIntent() {
+  switch (_intent.action) {
+    case Intent::Action::ACTIVATE_SKILL: {
+      auto& skillbook = _npc.getSkillBook()[Skill::Type::MAGIC];
+      if (skillbook.size()) {
+        _npc.activateSkill(skillbook.front());
+      }
+      break;
+    }
+    case Intent::Action::ATTACK: {
+      const optional<Character::State> attackState = _npc.getCombatSystem().determineNextAttackState();
+      if (!attackState.has_value()) {
+        _npc.attack();
+        break;
+      }
+      if (!handleCombatMotion(_npc, *attackState)) {
+        VGLOG(LOG_ERR, "Failed to handle combat motion, character: [%s], attackState: [%d]",
+              _npc.getCharacterProfile().jsonFilePath.c_str(), *attackState);
+      }
+      break;
+    }
+    case Intent::Action::FIND_NEW_LOCKED_ON_TARGET: {
+      const Character* killedTarget = _npc.getLockedOnTarget();
+      _npc.setLockedOnTarget(nullptr);
+      if (killedTarget) {
+        findNewLockedOnTargetFromParty(killedTarget);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  _moveIntent = _intent.moveIntent;
+  replayMoveIntent();
+
+  if (_intent.shouldJumpDown) {
+    _npc.jumpDown();
+  } else if (_intent.shouldDoubleJump) {
+    _npc.doubleJump();
+  } else if (_intent.shouldJump) {
+    _npc.jump();
+  }
+
+  // The callback may set a new move destination.
+  if (_intent.hasArrivedAtMoveDest && _onArrivalAtMoveDest) {
+    auto onArrivalAtMoveDest = std::move(_onArrivalAtMoveDest);
+    _onArrivalAtMoveDest = nullptr;
+    std::invoke(onArrivalAtMoveDest);
   }
 }
 
@@ -92,13 +184,101 @@ void NpcController::setMoveDest(const b2Vec2& targetPos, function<void()> onArri
   _onArrivalAtMoveDest = std::move(onArrivalAtTarget);
 }
 
+void NpcController::perceive(const float delta) {
+  _perception = Perception{};
+  _perception.delta = delta;
+  _perception.canAct = !_npc.isKilled() && !_npc.isSetToKill() && !_npc.isAttacking();
+  if (!_perception.canAct) {
+    return;
+  }
+
+  _perception.pos = _npc.getBody()->GetPosition();
+
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  _perception.navTiledMap = &gmMgr->getGameMap()->getNavTiledMap();
+
+  if (Character* lockedOnTarget = _npc.getLockedOnTarget()) {
+    _perception.lockedOnTarget = lockedOnTarget;
+    _perception.isLockedOnTargetSetToKill = lockedOnTarget->isSetToKill();
+    _perception.isLockedOnTargetInRange = _npc.getInRangeTargets().contains(lockedOnTarget);
+    if (lockedOnTarget->getBody()) {
+      _perception.lockedOnTargetPos = lockedOnTarget->getBody()->GetPosition();
+    } else {
+      VGLOG(LOG_WARN, "Unable to move to target: %s (b2body missing)",
+                      lockedOnTarget->getCharacterProfile().name.c_str());
+    }
+  }
+
+  _perception.hasMagicSkill = !_npc.getSkillBook()[Skill::Type::MAGIC].empty();
+  _perception.isUsingSkill = _npc.isUsingSkill();
+  _perception.attackRange = _npc.getCharacterProfile().attackRange / kPpm;
+
+  if (_npc.getParty() && !_npc.isWaitingForPartyLeader()) {
+    const Character* leader = _npc.getParty()->getLeader();
+    _perception.shouldFollowPartyLeader = true;
+    if (leader->getBody()) {
+      _perception.partyLeaderPos = leader->getBody()->GetPosition();
+    }
+  }
+
+  // The random numbers are drawn here rather than in decide(),
+  // because the random engine isn't meant to be used across threads.
+  if (_isSandboxing && _moveTimer >= _moveDuration && _waitTimer >= _waitDuration) {
+    rerollRandomMovement(kSandboxMinMoveDuration, kSandboxMaxMoveDuration,
+                         kSandboxMinWaitDuration, kSandboxMaxWaitDuration);
+  }
+}
+
+NpcController::Lod NpcController::determineLod() const {
+  // Npcs which have something to do are always near, no matter where they are.
+  if (_wakeUpTimer > 0 ||
+      _npc.getLockedOnTarget() ||
+      _moveDest.x || _moveDest.y ||
+      (_npc.getParty() && !_npc.isWaitingForPartyLeader())) {
+    return Lod::NEAR;
+  }
+
+  const Vec2& cameraPos = SceneManager::the().getCurrentScene<GameScene>()->getGameCamera()->getPosition();
+  const Size& winSize = Director::getInstance()->getWinSize();
+  const b2Vec2& thisPos = _npc.getBody()->GetPosition();
+  const float dx = std::max(0.0f, std::abs(thisPos.x * kPpm - cameraPos.x) - winSize.width / 2);
+  const float dy = std::max(0.0f, std::abs(thisPos.y * kPpm - cameraPos.y) - winSize.height / 2);
+  float dist = std::hypotf(dx, dy) / kPpm;
+
+  // The camera lags behind the player and stops at the edges of the map,
+  // so the npcs close to the player count as near even if they are off-screen.
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  if (const Player* player = gmMgr->getPlayer(); player && player->getBody()) {
+    dist = std::min(dist, (player->getBody()->GetPosition() - thisPos).Length());
+  }
+
+  if (dist <= kNearLodDistToViewport) {
+    return Lod::NEAR;
+  } else if (dist <= kMidLodDistToViewport) {
+    return Lod::MID;
+  }
+  return Lod::FAR;
+}
+
+void NpcController::replayMoveIntent() {
+  if (_npc.isKilled() || _npc.isSetToKill()) {
+    return;
+  }
+
+  if (_moveIntent == MoveIntent::LEFT) {
+    _npc.moveLeft();
+  } else if (_moveIntent == MoveIntent::RIGHT) {
+    _npc.moveRight();
+  }
+}
+
 void NpcController::findNewLockedOnTargetFromParty(const Character* killedTarget) {
   if (!killedTarget->getParty()) {
     return;
   }
 
   for (auto member : killedTarget->getParty()->getLeaderAndMembers()) {
-    if (!member->isSetToKill()) {
+    if (!member->isSetToKill() && _npc.isHostile(member)) {
       _npc.setLockedOnTarget(member);
       return;
     }
@@ -112,67 +292,37 @@ bool NpcController::isTooFarAwayFromTarget(const Character* target) const {
   return std::hypotf(targetPos.x - thisPos.x, targetPos.y - thisPos.y) > kAllyTeleportDist;
 }
 
-void NpcController::moveToTarget(const float delta, Character* target, const float followDist) {
-  if (!target->getBody()) {
-    VGLOG(LOG_WARN, "Unable to move to target: %s (b2body missing)",
-                    target->getCharacterProfile().name.c_str());
-    return;
-  }
-
-  moveToTarget(delta, target->getBody()->GetPosition(), followDist);
-}
-
 void NpcController::moveToTarget(const float delta, const b2Vec2& targetPos, const float followDist) {
-  const b2Vec2& thisPos = _npc.getBody()->GetPosition();
+  const b2Vec2& thisPos = _perception.pos;
 
   if (!_moveDest.x && !_moveDest.y) {
-    const optional<b2Vec2> waypoint = _pathFinder->getNextWaypoint(thisPos, targetPos, followDist);
+    const optional<b2Vec2> waypoint =
+        _pathFinder->getNextWaypoint(*_perception.navTiledMap, thisPos, targetPos, followDist);
     if (!waypoint.has_value()) {
       return;
     }
 
-    auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
-    Vec2 tileCoord = gmMgr->getGameMap()->getNavTiledMap().getTileCoordinate(Vec2{waypoint->x * kPpm, waypoint->y * kPpm});
-    Vec2 tileOrigin = gmMgr->getGameMap()->getNavTiledMap().getTilePos(tileCoord); // in pixels, probably top-left or bottom-left depending on orientation
-
-    Vec2 p1 = tileOrigin + Vec2(-8, 8);   // top-left
-    Vec2 p2 = tileOrigin + Vec2(8, 8);    // top-right
-    Vec2 p3 = tileOrigin + Vec2(8, -8);   // bottom-right
-    Vec2 p4 = tileOrigin + Vec2(-8, -8);  // bottom-left
-
-    auto draw = ax::DrawNode::create();
-    draw->drawRect(p1, p2, p3, p4, ax::Color4F::GREEN, 1);
-    ax_util::addChildWithParentCameraMask(gmMgr->getLayer(), draw, 100);
-
-    CallbackManager::the().runAfter([draw](const CallbackManager::CallbackId) {
-      SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager()->getLayer()->removeChild(draw);
-    }, 5.0f);
-
     _moveDest = waypoint.value();
   }
 
-  VGLOG(LOG_INFO, "thisPos: [%f, %f], targetPos: [%f, %f], waypoint: [%f,%f]",
-        thisPos.x, thisPos.y, targetPos.x, targetPos.y, _moveDest.x, _moveDest.y);
-
   if (std::hypotf(_moveDest.x - thisPos.x, _moveDest.y - thisPos.y) <= followDist) {
-    if (_onArrivalAtMoveDest) {
-      std::invoke(_onArrivalAtMoveDest);
-      _onArrivalAtMoveDest = nullptr;
-    }
+    _intent.hasArrivedAtMoveDest = true;
     _moveDest.SetZero();
     return;
   }
-  
+
+  _intent.action = Intent::Action::MOVE;
+
   const float kMoveThreshold = static_cast<float>(16) / kPpm;
   if (_moveDest.x < thisPos.x - kMoveThreshold) {
-    _npc.moveLeft();
+    _intent.moveIntent = MoveIntent::LEFT;
   } else if (_moveDest.x > thisPos.x + kMoveThreshold) {
-    _npc.moveRight();
+    _intent.moveIntent = MoveIntent::RIGHT;
   }
   if (_moveDest.y < thisPos.y - kMoveThreshold) {
-    _npc.jumpDown();
+    _intent.shouldJumpDown = true;
   } else if (_moveDest.y > thisPos.y + kMoveThreshold) {
-    _npc.doubleJump();
+    _intent.shouldDoubleJump = true;
   }
 
   // Sometimes when two Npcs are too close to each other,
@@ -183,28 +333,28 @@ void NpcController::moveToTarget(const float delta, const b2Vec2& targetPos, con
   //jumpIfStucked(delta, kJumpCheckInterval);
 }
 
-void NpcController::moveRandomly(const float delta,
-                                 const int minMoveDuration, const int maxMoveDuration,
-                                 const int minWaitDuration, const int maxWaitDuration) {
-  // If the character has finished moving and waiting, regenerate random values for
-  // _moveDuration and _waitDuration within the specified range.
-  if (_moveTimer >= _moveDuration && _waitTimer >= _waitDuration) {
-    _isMovingRight = static_cast<bool>(rand_util::randInt(0, 1));
-    _moveDuration = rand_util::randInt(minMoveDuration, maxMoveDuration);
-    _waitDuration = rand_util::randInt(minWaitDuration, maxWaitDuration);
-    _moveTimer = 0;
-    _waitTimer = 0;
-  }
-
+void NpcController::moveRandomly(const float delta) {
   if (_moveTimer >= _moveDuration) {
     _waitTimer += delta;
   } else {
     _moveTimer += delta;
-    (_isMovingRight) ? _npc.moveRight() : _npc.moveLeft();
+    _intent.action = Intent::Action::MOVE;
+    _intent.moveIntent = _isMovingRight ? MoveIntent::RIGHT : MoveIntent::LEFT;
     jumpIfStucked(delta, /*checkInterval=*/.5f);
   }
 }
 
+void NpcController::rerollRandomMovement(const int minMoveDuration, const int maxMoveDuration,
+                                         const int minWaitDuration, const int maxWaitDuration) {
+  // The character has finished moving and waiting, so regenerate random values for
+  // _moveDuration and _waitDuration within the specified range.
+  _isMovingRight = static_cast<bool>(rand_util::randInt(rand_util::Stream::AI, 0, 1));
+  _moveDuration = rand_util::randInt(rand_util::Stream::AI, minMoveDuration, maxMoveDuration);
+  _waitDuration = rand_util::randInt(rand_util::Stream::AI, minWaitDuration, maxWaitDuration);
+  _moveTimer = 0;
+  _waitTimer = 0;
+}
+
 void NpcController::jumpIfStucked(const float delta, const float checkInterval) {
   // If we haven't reached checkInterval yet, add delta to the timer
   // and return at once.
@@ -215,12 +365,38 @@ void NpcController::jumpIfStucked(const float delta, const float checkInterval)
 
   // We've reached checkInterval, so we can make this character jump
   // if it hasn't moved at all, and then reset the timer.
-  if (std::abs(_npc.getBody()->GetPosition().x - _lastStoppedPosition.x) == 0) {
-    _npc.jump();
+  if (std::abs(_perception.pos.x - _lastStoppedPosition.x) == 0) {
+    _intent.shouldJump = true;
   }
 
-  _lastStoppedPosition = {_npc.getBody()->GetPosition().x, _npc.getBody()->GetPosition().y};
+  _lastStoppedPosition = _perception.pos;
   _calculateDistanceTimer = 0;
 }
 
+void NpcController::drawDebugInfo() const {
+  auto debugOverlay = SceneManager::the().getCurrentScene<GameScene>()->getDebugOverlay();
+  if (!debugOverlay->isEnabled(DebugOverlay::Category::NAVIGATION)) {
+    return;
+  }
+
+  constexpr array<const char*, 3> kLodNames{{"near", "mid", "far"}};
+  const b2Vec2& b2bodyPos = _npc.getBody()->GetPosition();
+  const Vec2 pos{b2bodyPos.x * kPpm, b2bodyPos.y * kPpm};
+  debugOverlay->drawText(DebugOverlay::Category::NAVIGATION, pos + Vec2{0, 24},
+                         kLodNames[static_cast<int>(_lod)], Color4F::YELLOW);
+
+  if (!_moveDest.x && !_moveDest.y) {
+    return;
+  }
+
+  // Outline the nav tile of the current waypoint, and the way there.
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  const NavTiledMap& navTiledMap = gmMgr->getGameMap()->getNavTiledMap();
+  const Vec2 waypoint{_moveDest.x * kPpm, _moveDest.y * kPpm};
+  const Vec2 tileOrigin = navTiledMap.getTilePos(navTiledMap.getTileCoordinate(waypoint));
+  debugOverlay->drawRect(DebugOverlay::Category::NAVIGATION,
+                         tileOrigin + Vec2{-8, -8}, tileOrigin + Vec2{8, 8}, Color4F::GREEN);
+  debugOverlay->drawLine(DebugOverlay::Category::NAVIGATION, pos, waypoint, Color4F::GREEN);
+}
+
 }  // namespace requiem
@@ -4,6 +4,7 @@
 #define REQUIEM_CHARACTER_NPC_CONTROLLER_H_
 
 #include <functional>
+#include <optional>
 
 #include <box2d/box2d.h>
 
@@ -14,31 +15,112 @@ namespace requiem {
 class Character;
 class Npc;
 
+// The Npc's AI runs in three phases:
+// (1) perceive(): captures what the Npc needs to know about the world (main thread).
+// (2) decide(): decides what to do based on the perception only (any thread).
+// (3) applyIntent(): carries out the decision on the Npc (main thread).
+// This keeps decide(), which contains the path queries, away from Box2D and Axmol
+// objects, so that NpcAiScheduler can run it for many Npcs in parallel.
 class NpcController final {
  public:
+  // The level of detail of the Npc's AI, determined by its distance to the viewport.
+  // NEAR: thinks every frame.
+  // MID: thinks every few frames, and keeps moving the same way in between.
+  // FAR: only patrols (if sandboxing) every several frames, otherwise sleeps.
+  enum class Lod {
+    NEAR,
+    MID,
+    FAR
+  };
+
   explicit NpcController(Npc& npc);
 
   void update(const float delta);
+  void decide();
+  void applyIntent();
   void setMoveDest(const b2Vec2& targetPos, std::function<void()> onArrivalAtTarget);
 
+  // Forces the Npc to think every frame for a while, e.g., after receiving damage.
+  inline void wakeUp() { _wakeUpTimer = kWakeUpDuration; }
+  inline Lod getLod() const { return _lod; }
+
   inline void reverseDirection() { _isMovingRight = !_isMovingRight; }
   inline bool isSandboxing() const { return _isSandboxing; }
   inline void setSandboxing(const bool sandboxing) { _isSandboxing = sandboxing; }
   inline void clearMoveDest() { _moveDest.SetZero(); }
 
  private:
+  enum class MoveIntent {
+    NONE,
+    LEFT,
+    RIGHT
+  };
+
+  // A read-only snapshot of the world from this Npc's point of view.
+  struct Perception final {
+    float delta{};
+    bool canAct{};
+    const NavTiledMap* navTiledMap{};
+    b2Vec2 pos{0.f, 0.f};
+    // Only used as an identity, and never dereferenced in decide().
+    const Character* lockedOnTarget{};
+    bool isLockedOnTargetSetToKill{};
+    bool isLockedOnTargetInRange{};
+    std::optional<b2Vec2> lockedOnTargetPos;
+    bool hasMagicSkill{};
+    bool isUsingSkill{};
+    float attackRange{};
+    bool shouldFollowPartyLeader{};
+    std::optional<b2Vec2> partyLeaderPos;
+  };
+
+  struct Intent final {
+    enum class Action {
+      NONE,
+      ACTIVATE_SKILL,
+      ATTACK,
+      FIND_NEW_LOCKED_ON_TARGET,
+      MOVE
+    };
+
+    Action action{Action::NONE};
+    MoveIntent moveIntent{MoveIntent::NONE};
+    bool shouldJump{};
+    bool shouldJumpDown{};
+    bool shouldDoubleJump{};
+    bool hasArrivedAtMoveDest{};
+  };
+
+  void perceive(const float delta);
+  Lod determineLod() const;
+  void replayMoveIntent();
   void findNewLockedOnTargetFromParty(const Character* killedTarget);
   bool isTooFarAwayFromTarget(const Character* target) const;
-  void moveToTarget(const float delta, Character* target, const float followDist);
   void moveToTarget(const float delta, const b2Vec2& targetPos, const float followDist);
-  void moveRandomly(const float delta,
-                    const int minMoveDuration, const int maxMoveDuration,
-                    const int minWaitDuration, const int maxWaitDuration);
+  void moveRandomly(const float delta);
+  void rerollRandomMovement(const int minMoveDuration, const int maxMoveDuration,
+                            const int minWaitDuration, const int maxWaitDuration);
   void jumpIfStucked(const float delta, const float checkInterval);
+  void drawDebugInfo() const;
+
+  static inline constexpr float kWakeUpDuration = 5.0f;
+  static inline constexpr unsigned int kMidLodFrameInterval = 4;
+  static inline constexpr unsigned int kFarLodFrameInterval = 16;
+
+  // Spreads the Npcs across the frames so that the mid/far ones don't think at the same frame.
+  static inline unsigned int _nextLodBucket{};
 
   Npc& _npc;
   std::unique_ptr<PathFinder> _pathFinder;
 
+  Lod _lod{Lod::NEAR};
+  unsigned int _lodBucket{};
+  float _lodTimer{};
+  float _wakeUpTimer{};
+  MoveIntent _moveIntent{MoveIntent::NONE};
+  Perception _perception;
+  Intent _intent;
+
   bool _isSandboxing{};
   bool _isMovingRight{};
   float _moveDuration{};
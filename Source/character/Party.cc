@@ -2,6 +2,8 @@
 
 #include "Party.h"
 
+#include <algorithm>
+
 #include <box2d/box2d.h>
 
 #include "Constants.h"
@@ -158,16 +160,6 @@ Party::getWaitingMemberLocationInfo(const std::string& characterJsonFilePath) co
   return it->second;
 }
 
-unordered_set<Character*> Party::getLeaderAndMembers() const {
-  unordered_set<Character*> allMembers;
-
-  allMembers.insert(_leader);
-  for (const auto& member : _members) {
-    allMembers.insert(member.get());
-  }
-  return allMembers;
-}
-
 void Party::dump() {
   VGLOG(LOG_INFO, "Dumping player party");
   for (const auto& member : _members) {
@@ -181,6 +173,7 @@ void Party::dump() {
 
 void Party::addMember(shared_ptr<Character> character) {
   character->setParty(_leader->getParty());
+  _leaderAndMembers.push_back(character.get());
   _members.insert(std::move(character));
 }
 
@@ -198,6 +191,8 @@ shared_ptr<Character> Party::removeMember(Character* character) {
 
   removedMember = std::move(*it);
   _members.erase(it);
+  _leaderAndMembers.erase(std::remove(_leaderAndMembers.begin(), _leaderAndMembers.end(), character),
+                          _leaderAndMembers.end());
   return removedMember;
 }
 
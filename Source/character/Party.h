@@ -3,28 +3,93 @@
 #ifndef REQUIEM_CHARACTER_PARTY_H_
 #define REQUIEM_CHARACTER_PARTY_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace requiem {
 
 // Forward declaration
 class Character;
 
+// A non-owning view over the leader and members of a party except one of them,
+// i.e., the allies of that character. Iterating over it never allocates.
+class AllyView final {
+ public:
+  class Iterator final {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Character*;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Character* const*;
+    using reference = Character* const&;
+
+    Iterator(std::vector<Character*>::const_iterator it,
+             std::vector<Character*>::const_iterator end,
+             const Character* excluded)
+        : _it{it}, _end{end}, _excluded{excluded} {
+      skipExcluded();
+    }
+
+    inline reference operator*() const { return *_it; }
+    inline Iterator& operator++() { ++_it; skipExcluded(); return *this; }
+    inline Iterator operator++(int) { Iterator ret = *this; ++(*this); return ret; }
+    inline bool operator==(const Iterator& other) const { return _it == other._it; }
+    inline bool operator!=(const Iterator& other) const { return _it != other._it; }
+
+   private:
+    inline void skipExcluded() {
+      if (_it != _end && *_it == _excluded) {
+        ++_it;
+      }
+    }
+
+    std::vector<Character*>::const_iterator _it;
+    std::vector<Character*>::const_iterator _end;
+    const Character* _excluded;
+  };
+
+  AllyView() = default;
+  AllyView(const std::vector<Character*>& characters, const Character* excluded)
+      : _characters{&characters}, _excluded{excluded} {}
+
+  inline Iterator begin() const {
+    return _characters ? Iterator{_characters->begin(), _characters->end(), _excluded} : Iterator{{}, {}, nullptr};
+  }
+  inline Iterator end() const {
+    return _characters ? Iterator{_characters->end(), _characters->end(), _excluded} : Iterator{{}, {}, nullptr};
+  }
+  inline bool empty() const { return begin() == end(); }
+
+ private:
+  const std::vector<Character*>* _characters{};
+  const Character* _excluded{};
+};
+
 class Party final {
   friend class GameState;
 
  public:
+  // Compact integer ids of parties. Characters without a party belong to kNoTeam.
+  using TeamId = uint32_t;
+  static inline constexpr TeamId kNoTeam = 0;
+
   struct WaitingLocationInfo {
     std::string tmxMapFilePath;
     float x;
     float y;
   };
 
-  explicit Party(Character* leader) : _leader{leader} {}
+  explicit Party(Character* leader)
+      : _leader{leader},
+        _teamId{_nextTeamId++},
+        _leaderAndMembers{leader} {}
 
   Character* getMember(const std::string& characterJsonFilePath) const;
   bool hasMember(const std::string& characterJsonFilePath) const;
@@ -50,7 +115,8 @@ class Party final {
 
   inline const std::unordered_set<std::shared_ptr<Character>>& getMembers() const { return _members; }
   inline Character* getLeader() const { return _leader; }
-  std::unordered_set<Character*> getLeaderAndMembers() const;
+  inline const std::vector<Character*>& getLeaderAndMembers() const { return _leaderAndMembers; }
+  inline TeamId getTeamId() const { return _teamId; }
 
   inline const std::unordered_map<std::string, Party::WaitingLocationInfo>&
   getWaitingMembersLocationInfos() const {
@@ -63,9 +129,15 @@ class Party final {
   void addMember(std::shared_ptr<Character> character);
   std::shared_ptr<Character> removeMember(Character* character);
 
+  static inline TeamId _nextTeamId{kNoTeam + 1};
+
   // `_leader` will NOT be in `_members`.
   Character* _leader{};
+  TeamId _teamId{};
   std::unordered_set<std::shared_ptr<Character>> _members;
+  // `_leader` followed by the members, kept in sync with `_members`
+  // so that they can be iterated over without building a new container.
+  std::vector<Character*> _leaderAndMembers;
   std::unordered_map<std::string, Party::WaitingLocationInfo> _waitingMembersLocationInfos;
 };
 
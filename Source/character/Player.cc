@@ -42,6 +42,7 @@ Player::Player(const fs::path& jsonFilePath)
       _playerController{*this} {
   // The player has a party (team) with no other members by default.
   _party = std::make_shared<Party>(this);
+  _factionId = faction::kPlayer;
 }
 
 bool Player::showOnMap(float x, float y) {
@@ -58,7 +59,7 @@ bool Player::showOnMap(float x, float y) {
   defineTexture(_characterProfile.textureResDirPath, x, y);
 
   _node->removeAllChildren();
-  _node->addChild(_bodySpritesheet, z_order::kPlayerBody);
+  addBodySpriteToSpriteBatch(z_order::kPlayerBody);
 
   auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
   ax_util::addChildWithParentCameraMask(gmMgr->getLayer(), _node, z_order::kPlayerBody);
@@ -72,6 +73,11 @@ void Player::onKilled() {
   const bool isGameOverOnPlayerKilled = gmMgr->getGameMap()->isGameOverOnPlayerKilled();
 
   Character::onKilled();
+
+  // Losing a boss fight takes the player back to the checkpoint of this game map.
+  if (isInBossFight && isGameOverOnPlayerKilled && gmMgr->retryFromCheckpoint()) {
+    return;
+  }
   if (!isInBossFight || isGameOverOnPlayerKilled) {
     SceneManager::the().getCurrentScene<GameScene>()->setActive(false);
   }
@@ -102,7 +108,7 @@ bool Player::receiveDamage(Character* source, int damage) {
   }
 
   _isInvincible = true;
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId){
+  runAfter([this](const CallbackManager::CallbackId){
     _isInvincible = false;
   }, 1.0f);
 
@@ -0,0 +1,70 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#include "DamageQueue.h"
+
+#include <algorithm>
+
+#include "character/Character.h"
+#include "util/Logger.h"
+
+using namespace std;
+
+namespace requiem {
+
+DamageQueue::DamageQueue() {
+  _damageEvents.reserve(kInitialCapacity);
+  _resolvingDamageEvents.reserve(kInitialCapacity);
+}
+
+void DamageQueue::push(const DamageEvent& damageEvent) {
+  if (!damageEvent.target) {
+    VGLOG(LOG_ERR, "Failed to queue damage event, target: [nullptr].");
+    return;
+  }
+
+  _damageEvents.push_back(damageEvent);
+}
+
+void DamageQueue::resolve() {
+  if (_damageEvents.empty()) {
+    return;
+  }
+
+  // Merge the events with the same source and target, keeping the order of their first hits.
+  _resolvingDamageEvents.clear();
+  for (const auto& damageEvent : _damageEvents) {
+    auto it = std::find_if(_resolvingDamageEvents.begin(), _resolvingDamageEvents.end(),
+                           [&damageEvent](const DamageEvent& e) {
+      return e.source == damageEvent.source && e.target == damageEvent.target;
+    });
+    if (it == _resolvingDamageEvents.end()) {
+      _resolvingDamageEvents.push_back(damageEvent);
+      continue;
+    }
+    it->damage += damageEvent.damage;
+    it->knockBackForce += damageEvent.knockBackForce;
+  }
+  _damageEvents.clear();
+
+  for (const auto& damageEvent : _resolvingDamageEvents) {
+    if (!damageEvent.source) {
+      damageEvent.target->receiveDamage(damageEvent.damage);
+      continue;
+    }
+
+    if (damageEvent.knockBackForce.x || damageEvent.knockBackForce.y) {
+      damageEvent.source->knockBack(damageEvent.target,
+                                    damageEvent.knockBackForce.x,
+                                    damageEvent.knockBackForce.y);
+    }
+    damageEvent.source->inflictDamage(damageEvent.target, damageEvent.damage);
+  }
+  _resolvingDamageEvents.clear();
+}
+
+void DamageQueue::clear() {
+  _damageEvents.clear();
+  _resolvingDamageEvents.clear();
+}
+
+}  // namespace requiem
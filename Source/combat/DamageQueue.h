@@ -0,0 +1,49 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_COMBAT_DAMAGE_QUEUE_H_
+#define REQUIEM_COMBAT_DAMAGE_QUEUE_H_
+
+#include <vector>
+
+#include <box2d/box2d.h>
+
+namespace requiem {
+
+class Character;
+
+// The damage dealt within a frame is queued instead of being applied right away,
+// and is resolved in a single pass after the physics step. The hits dealt by the
+// same source to the same target are merged into one, so the target's health,
+// HUD, floating damage and death are handled once per source per frame, in the
+// order that the targets were first hit.
+class DamageQueue final {
+ public:
+  struct DamageEvent final {
+    Character* source{};  // nullptr if the damage comes from traps.
+    Character* target{};
+    int damage{};
+    b2Vec2 knockBackForce{0.f, 0.f};
+  };
+
+  DamageQueue();
+  DamageQueue(const DamageQueue&) = delete;
+  DamageQueue& operator=(const DamageQueue&) = delete;
+
+  void push(const DamageEvent& damageEvent);
+  void resolve();
+  void clear();
+
+  inline int getNumQueuedEvents() const { return static_cast<int>(_damageEvents.size()); }
+
+ private:
+  static inline constexpr size_t kInitialCapacity = 64;
+
+  std::vector<DamageEvent> _damageEvents;
+  // The merged events being resolved. Any damage dealt during
+  // the resolution goes to `_damageEvents` for the next frame.
+  std::vector<DamageEvent> _resolvingDamageEvents;
+};
+
+}  // namespace requiem
+
+#endif  // REQUIEM_COMBAT_DAMAGE_QUEUE_H_
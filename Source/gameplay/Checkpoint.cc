@@ -0,0 +1,219 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#include "Checkpoint.h"
+
+#include "Constants.h"
+#include "character/Npc.h"
+#include "character/Player.h"
+#include "scene/GameScene.h"
+#include "scene/SceneManager.h"
+#include "util/Logger.h"
+
+using namespace std;
+
+namespace requiem {
+
+namespace {
+
+shared_ptr<Npc> findNpc(GameMap* gameMap, const uint32_t instanceId) {
+  for (const auto& actor : gameMap->getDynamicActors()) {
+    auto npc = dynamic_pointer_cast<Npc>(actor);
+    if (npc && npc->getInstanceId() == instanceId) {
+      return npc;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+void Checkpoint::capture() {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  auto gameMap = gmMgr->getGameMap();
+  auto player = gmMgr->getPlayer();
+  if (!gameMap || !player) {
+    VGLOG(LOG_ERR, "Failed to capture checkpoint, there's no game map or player.");
+    return;
+  }
+
+  clear();
+  _tmxMapFilePath = gameMap->getTmxTiledMapFilePath();
+  _player = captureCharacter(player);
+
+  for (const auto& member : player->getParty()->getMembers()) {
+    _partyMembers.emplace_back(member, captureCharacter(member.get()));
+  }
+  for (const auto& actor : gameMap->getDynamicActors()) {
+    // The dead stay dead, and the spawning blacklist below takes care of them.
+    auto npc = dynamic_pointer_cast<Npc>(actor);
+    if (!npc || npc->isSetToKill() || npc->isKilled() || !npc->getBody()) {
+      continue;
+    }
+
+    _npcs.push_back({npc, WorldStreamer::makeNpcSnapshot(*npc)});
+  }
+  for (auto& snapshot : gameMap->getWorldStreamer().getNpcSnapshots()) {
+    _npcs.push_back({{}, std::move(snapshot)});
+  }
+
+  _hasTriggered.reserve(gameMap->getTriggers().size());
+  for (const auto& trigger : gameMap->getTriggers()) {
+    _hasTriggered.push_back(trigger->hasTriggered());
+  }
+
+  for (const auto quest : player->getQuestBook().getInProgressQuests()) {
+    _inProgressQuests.emplace_back(quest, quest->getCurrentStageIdx());
+  }
+  for (const auto quest : player->getQuestBook().getCompletedQuests()) {
+    _completedQuests.emplace_back(quest, quest->getCurrentStageIdx());
+  }
+
+  _npcSpawningBlacklist = gmMgr->_npcSpawningBlacklist;
+  _allOpenableObjectStates = gmMgr->_allOpenableObjectStates;
+  _activatedTriggers = gmMgr->_activatedTriggers;
+}
+
+bool Checkpoint::restore() {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  auto gameMap = gmMgr->getGameMap();
+  auto player = gmMgr->getPlayer();
+  if (!isCaptured() || !gameMap || !player) {
+    VGLOG(LOG_ERR, "Failed to restore checkpoint, no checkpoint has been captured.");
+    return false;
+  }
+  if (gameMap->getTmxTiledMapFilePath() != _tmxMapFilePath) {
+    VGLOG(LOG_ERR, "Failed to restore checkpoint of [%s] in [%s].",
+          _tmxMapFilePath.c_str(), gameMap->getTmxTiledMapFilePath().c_str());
+    return false;
+  }
+
+  // The boss fight starts over once its trigger, which is restored below, is triggered again.
+  gameMap->cancelBossFight();
+
+  // The spawning blacklist is restored first, since restoreNpc() checks it.
+  gmMgr->_npcSpawningBlacklist = _npcSpawningBlacklist;
+  gmMgr->_allOpenableObjectStates = _allOpenableObjectStates;
+  gmMgr->_activatedTriggers = _activatedTriggers;
+
+  restoreCharacter(player, _player);
+  for (const auto& [weakCharacter, state] : _partyMembers) {
+    if (auto character = weakCharacter.lock()) {
+      restoreCharacter(character.get(), state);
+    }
+  }
+  for (const auto& npcState : _npcs) {
+    restoreNpc(npcState);
+  }
+
+  const auto& triggers = gameMap->getTriggers();
+  for (size_t i = 0; i < triggers.size() && i < _hasTriggered.size(); i++) {
+    triggers[i]->setTriggered(_hasTriggered[i]);
+  }
+
+  QuestBook& questBook = player->getQuestBook();
+  questBook.reset();
+  for (const auto& [quest, stageIdx] : _inProgressQuests) {
+    quest->setCurrentStageIdx(stageIdx);
+    questBook._inProgressQuests.push_back(quest);
+  }
+  for (const auto& [quest, stageIdx] : _completedQuests) {
+    quest->setCurrentStageIdx(stageIdx);
+    questBook._completedQuests.push_back(quest);
+  }
+
+  auto hud = SceneManager::the().getCurrentScene<GameScene>()->getHud();
+  hud->updateStatusBars();
+
+  VGLOG(LOG_INFO, "Restored checkpoint of [%s].", _tmxMapFilePath.c_str());
+  return true;
+}
+
+void Checkpoint::clear() {
+  _tmxMapFilePath.clear();
+  _partyMembers.clear();
+  _npcs.clear();
+  _hasTriggered.clear();
+  _inProgressQuests.clear();
+  _completedQuests.clear();
+  _npcSpawningBlacklist.clear();
+  _allOpenableObjectStates.clear();
+  _activatedTriggers.clear();
+}
+
+Checkpoint::CharacterState Checkpoint::captureCharacter(Character* character) {
+  const auto& profile = character->getCharacterProfile();
+
+  CharacterState state;
+  state.health = profile.health;
+  state.magicka = profile.magicka;
+  state.stamina = profile.stamina;
+  state.isFacingRight = character->isFacingRight();
+  state.isKilled = character->isSetToKill() || character->isKilled();
+  if (!state.isKilled && character->getBody()) {
+    state.pos = character->getBody()->GetPosition();
+  }
+  return state;
+}
+
+void Checkpoint::restoreCharacter(Character* character, const CharacterState& state) {
+  // The dead stay dead, and those in the middle of their killed animation are left alone.
+  if (state.isKilled || (character->isSetToKill() && !character->isKilled())) {
+    return;
+  }
+  if (character->isKilled()) {
+    character->resurrect();
+  }
+  if (!character->getBody()) {
+    return;
+  }
+
+  character->setLockedOnTarget(nullptr);
+  character->setFacingRight(state.isFacingRight);
+  character->setPosition(state.pos.x, state.pos.y);
+  character->getBody()->SetLinearVelocity({0, 0});
+
+  auto& profile = character->getCharacterProfile();
+  profile.health = state.health;
+  profile.magicka = state.magicka;
+  profile.stamina = state.stamina;
+}
+
+void Checkpoint::restoreNpc(const NpcState& npcState) {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  auto gameMap = gmMgr->getGameMap();
+  const WorldStreamer::NpcSnapshot& snapshot = npcState.snapshot;
+
+  shared_ptr<Npc> npc = npcState.npc.lock();
+  if (npc && !gameMap->getDynamicActors().contains(npc)) {
+    // It has joined a party since the capture, which owns it from then on.
+    if (npc->getParty()) {
+      return;
+    }
+    npc = nullptr;
+  }
+  if (!npc) {
+    npc = findNpc(gameMap, snapshot.instanceId);
+  }
+
+  // Restore it in place if it is still around and alive.
+  if (npc) {
+    if (!npc->isSetToKill() && !npc->isKilled()) {
+      const Character::Profile& profile = npc->getCharacterProfile();
+      CharacterState state;
+      state.pos = {snapshot.pos.x / kPpm, snapshot.pos.y / kPpm};
+      state.health = snapshot.health.value_or(profile.fullHealth);
+      state.magicka = snapshot.magicka.value_or(profile.fullMagicka);
+      state.stamina = snapshot.stamina.value_or(profile.fullStamina);
+      state.isFacingRight = snapshot.isFacingRight.value_or(npc->isFacingRight());
+      restoreCharacter(npc.get(), state);
+      return;
+    }
+    // Otherwise it has been killed since the capture, so replace it with a new one.
+    gameMap->removeDynamicActor(npc.get());
+  }
+
+  // It is spawned right away if its chunk is loaded, or once it is.
+  gameMap->getWorldStreamer().restoreNpc(WorldStreamer::NpcSnapshot{snapshot});
+}
+
+}  // namespace requiem
@@ -0,0 +1,83 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_GAMEPLAY_CHECKPOINT_H_
+#define REQUIEM_GAMEPLAY_CHECKPOINT_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <box2d/box2d.h>
+
+#include "map/WorldStreamer.h"
+
+namespace requiem {
+
+class Character;
+class Npc;
+class Quest;
+
+// An in-memory snapshot of the volatile state of the current game map: the
+// player, the party, the npcs, the triggers and the quests. Unlike GameState,
+// restoring a checkpoint neither reads the save file nor reloads the game map,
+// it only writes the captured values back into the existing objects.
+//
+// A checkpoint is captured each time a game map has been loaded, and is restored
+// when the player is killed in a boss fight. It can also be captured/restored via
+// the `checkpoint` and `restorecheckpoint` commands.
+class Checkpoint final {
+ public:
+  Checkpoint() = default;
+  Checkpoint(const Checkpoint&) = delete;
+  Checkpoint& operator=(const Checkpoint&) = delete;
+
+  void capture();
+  bool restore();
+  void clear();
+
+  inline bool isCaptured() const { return !_tmxMapFilePath.empty(); }
+  inline const std::string& getTmxMapFilePath() const { return _tmxMapFilePath; }
+
+ private:
+  struct CharacterState final {
+    b2Vec2 pos{0.f, 0.f};
+    int health{};
+    int magicka{};
+    int stamina{};
+    bool isFacingRight{};
+    bool isKilled{};
+  };
+
+  // WorldStreamer may have swept an npc into a snapshot and re-created it since the
+  // capture, so it is also looked up by its instance id. The npcs which have been
+  // killed or removed since then are handed back to WorldStreamer as `snapshot`.
+  struct NpcState final {
+    std::weak_ptr<Npc> npc;  // empty if it was in an unloaded chunk upon capture.
+    WorldStreamer::NpcSnapshot snapshot;
+  };
+
+  static CharacterState captureCharacter(Character* character);
+  static void restoreCharacter(Character* character, const CharacterState& state);
+  static void restoreNpc(const NpcState& npcState);
+
+  std::string _tmxMapFilePath;
+  CharacterState _player;
+  // The party members are owned by the party rather than the game map,
+  // so they are restored in place if they still exist.
+  std::vector<std::pair<std::weak_ptr<Character>, CharacterState>> _partyMembers;
+  // The npcs which were alive upon capture, including those in the unloaded chunks.
+  std::vector<NpcState> _npcs;
+  std::vector<bool> _hasTriggered;
+  std::vector<std::pair<Quest*, int>> _inProgressQuests;
+  std::vector<std::pair<Quest*, int>> _completedQuests;
+  std::unordered_set<std::string> _npcSpawningBlacklist;
+  std::unordered_map<std::string, bool> _allOpenableObjectStates;
+  std::unordered_set<std::string> _activatedTriggers;
+};
+
+}  // namespace requiem
+
+#endif  // REQUIEM_GAMEPLAY_CHECKPOINT_H_
@@ -6,6 +6,7 @@
 
 #include "Assets.h"
 #include "Constants.h"
+#include "TextureManager.h"
 #include "item/Equipment.h"
 #include "item/Consumable.h"
 #include "item/MiscItem.h"
@@ -56,6 +57,7 @@ unique_ptr<Item> Item::create(const fs::path& jsonFilePath) {
 Item::Item(const fs::path& jsonFilePath)
     : DynamicActor{kItemNumAnimations, kItemNumFixtures},
       _itemProfile{jsonFilePath} {
+  TextureManager::the().acquire(getIconPath(), TextureManager::Category::ITEM);
   _bodySprite = Sprite::create(getIconPath().native());
   _bodySprite->getTexture()->setAliasTexParameters();
 }
@@ -71,6 +73,7 @@ bool Item::showOnMap(float x, float y) {
              kItemCategoryBits,
              kItemMaskBits);
 
+  TextureManager::the().acquire(getIconPath(), TextureManager::Category::ITEM);
   _bodySprite = Sprite::create(getIconPath().native());
   _bodySprite->getTexture()->setAliasTexParameters();
   _bodySprite->setScale(0.8f);
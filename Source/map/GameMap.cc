@@ -12,6 +12,7 @@
 #include "Audio.h"
 #include "CallbackManager.h"
 #include "Constants.h"
+#include "TextureManager.h"
 #include "character/Character.h"
 #include "character/Player.h"
 #include "character/Npc.h"
@@ -39,6 +40,26 @@ USING_NS_AX;
 
 namespace requiem {
 
+namespace {
+
+// How far the culling rect has to move before the static actors are re-examined.
+constexpr float kStaticActorsCullingStep = 64.0f;
+
+// Builds a TMXTiledMap from the TMXMapInfo which MapPrefetcher has already parsed,
+// since TMXTiledMap::createWithXML() would parse the .tmx file all over again.
+class PrefetchedTmxTiledMap final : public TMXTiledMap {
+ public:
+  static TMXTiledMap* create(TMXMapInfo* mapInfo) {
+    auto tmxTiledMap = new PrefetchedTmxTiledMap();
+    tmxTiledMap->setContentSize(Size::ZERO);
+    tmxTiledMap->buildWithMapInfo(mapInfo);
+    tmxTiledMap->autorelease();
+    return tmxTiledMap;
+  }
+};
+
+}  // namespace
+
 GameMap::GameMap(b2World* world, Lighting* lighting, const string& tmxMapFilePath)
     : _world{world},
       _lighting{lighting},
@@ -46,7 +67,23 @@ GameMap::GameMap(b2World* world, Lighting* lighting, const string& tmxMapFilePat
       _tmxTiledMapFilePath{tmxMapFilePath},
       _bgmFilePath{_tmxTiledMap->getProperty("bgm").asString()},
       _parallaxBackground{std::make_unique<ParallaxBackground>()},
-      _navTiledMap{std::make_unique<NavTiledMap>(*_tmxTiledMap)} {}
+      _navTiledMap{std::make_unique<NavTiledMap>(*_tmxTiledMap)},
+      _worldStreamer{std::make_unique<WorldStreamer>(world, *this, Size{getWidth(), getHeight()})} {
+  acquireTilesetTextures();
+}
+
+GameMap::GameMap(b2World* world, Lighting* lighting, const string& tmxMapFilePath,
+                 MapPrefetcher::PrefetchedMap&& prefetchedMap)
+    : _world{world},
+      _lighting{lighting},
+      _tmxTiledMap{PrefetchedTmxTiledMap::create(prefetchedMap.mapInfo.get())},
+      _tmxTiledMapFilePath{tmxMapFilePath},
+      _bgmFilePath{_tmxTiledMap->getProperty("bgm").asString()},
+      _parallaxBackground{std::make_unique<ParallaxBackground>()},
+      _navTiledMap{std::make_unique<NavTiledMap>(*_tmxTiledMap, std::move(prefetchedMap.navTiles))},
+      _worldStreamer{std::make_unique<WorldStreamer>(world, *this, Size{getWidth(), getHeight()})} {
+  acquireTilesetTextures();
+}
 
 GameMap::~GameMap() {
   for (auto& actor : _dynamicActors) {
@@ -57,10 +94,6 @@ GameMap::~GameMap() {
     actor->removeFromMap();
   }
 
-  for (auto body : _tmxTiledMapBodies) {
-    _world->DestroyBody(body);
-  }
-
   _lighting->clear();
 }
 
@@ -72,22 +105,32 @@ void GameMap::update(const float delta) {
   }
 }
 
-void GameMap::createObjects() {
-  list<b2Body*> bodies = createPolylines("Ground", category_bits::kGround, true, kGroundFriction);
-  _tmxTiledMapBodies.splice(_tmxTiledMapBodies.end(), bodies);
-
-  bodies = createPolylines("Wall", category_bits::kWall, true, kWallFriction);
-  _tmxTiledMapBodies.splice(_tmxTiledMapBodies.end(), bodies);
-
-  bodies = createRectangles("Platform", category_bits::kPlatform, true, kGroundFriction);
-  _tmxTiledMapPlatformBodies.insert(_tmxTiledMapPlatformBodies.end(), bodies.begin(), bodies.end());
-  _tmxTiledMapBodies.splice(_tmxTiledMapBodies.end(), bodies);
+void GameMap::cullStaticActors(const Rect& cullingRect) {
+  // Static actors never move, so they only have to be re-examined
+  // once the culling rect has moved far enough.
+  if (_lastStaticActorsCullingRect.has_value() &&
+      _lastStaticActorsCullingRect->size.equals(cullingRect.size) &&
+      std::abs(_lastStaticActorsCullingRect->origin.x - cullingRect.origin.x) < kStaticActorsCullingStep &&
+      std::abs(_lastStaticActorsCullingRect->origin.y - cullingRect.origin.y) < kStaticActorsCullingStep) {
+    return;
+  }
 
-  bodies = createPolylines("PivotMarker", category_bits::kPivotMarker, false, 0);
-  _tmxTiledMapBodies.splice(_tmxTiledMapBodies.end(), bodies);
+  _lastStaticActorsCullingRect = cullingRect;
+  for (const auto& actor : _staticActors) {
+    if (const Sprite* bodySprite = actor->getBodySprite()) {
+      actor->setCulled(!cullingRect.containsPoint(bodySprite->getPosition()));
+    }
+  }
+}
 
-  bodies = createPolylines("CliffMarker", category_bits::kCliffMarker, false, 0);
-  _tmxTiledMapBodies.splice(_tmxTiledMapBodies.end(), bodies);
+void GameMap::createObjects() {
+  // The static bodies, chests, npcs and animated objects are only prepared here,
+  // and are created by _worldStreamer once the chunk they are in is loaded.
+  createPolylines("Ground", category_bits::kGround, true, kGroundFriction);
+  createPolylines("Wall", category_bits::kWall, true, kWallFriction);
+  createRectangles("Platform", category_bits::kPlatform, true, kGroundFriction);
+  createPolylines("PivotMarker", category_bits::kPivotMarker, false, 0);
+  createPolylines("CliffMarker", category_bits::kCliffMarker, false, 0);
 
   if (auto bitmapLayer = _navTiledMap->getBitmapLayer()) {
     //bitmapLayer->setVisible(false);
@@ -127,7 +170,7 @@ Item* GameMap::createItem(const string& itemJson, float x, float y, int amount)
   Item* item = showDynamicActor<Item>(Item::create(itemJson), x, y);
   item->setAmount(amount);
 
-  float offsetX = rand_util::randFloat(-.3f, .3f);
+  float offsetX = rand_util::randFloat(rand_util::Stream::LOOT, -.3f, .3f);
   float offsetY = 3.0f;
   item->getBody()->ApplyLinearImpulse({offsetX, offsetY},
                                       item->getBody()->GetWorldCenter(),
@@ -169,8 +212,9 @@ bool GameMap::beginBossFight(const string& targetNpcJsonFilePath,
     target->lockOn(player);
   }, Subtitles::kLetterboxTransitionDuration);
 
-  target->addOnKilledCallback([this]() { endBossFight(/*isPlayerKilled=*/false); });
-  player->addOnKilledCallback([this]() { endBossFight(/*isPlayerKilled=*/true); });
+  _bossFightTarget = target;
+  _bossFightTargetOnKilledCallbackId = target->addOnKilledCallback([this]() { endBossFight(/*isPlayerKilled=*/false); });
+  _playerOnKilledCallbackId = player->addOnKilledCallback([this]() { endBossFight(/*isPlayerKilled=*/true); });
 
   for (const auto& trigger : _triggers) {
     trigger->onBossFightBegin();
@@ -206,6 +250,35 @@ void GameMap::endBossFight(const bool isPlayerKilled) {
   _isInBossFight = false;
   _isGameOverOnPlayerKilled = true;
   _execOnPlayerKilled.clear();
+  removeBossFightCallbacks();
+}
+
+void GameMap::cancelBossFight() {
+  if (!_isInBossFight) {
+    return;
+  }
+
+  for (const auto& trigger : _triggers) {
+    trigger->onBossFightEnd();
+  }
+
+  _isInBossFight = false;
+  _isGameOverOnPlayerKilled = true;
+  _execOnPlayerKilled.clear();
+  removeBossFightCallbacks();
+}
+
+void GameMap::removeBossFightCallbacks() {
+  if (auto target = _bossFightTarget.lock()) {
+    target->removeOnKilledCallback(_bossFightTargetOnKilledCallbackId);
+  }
+  _bossFightTarget.reset();
+
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  if (auto player = gmMgr->getPlayer(); player && _playerOnKilledCallbackId) {
+    player->removeOnKilledCallback(_playerOnKilledCallbackId);
+  }
+  _playerOnKilledCallbackId = 0;
 }
 
 float GameMap::getWidth() const {
@@ -226,10 +299,8 @@ ax::ValueVector GameMap::getObjects(const string& layerName) {
   return objectGroup->getObjects();
 }
 
-list<b2Body*> GameMap::createRectangles(const string& layerName, const short categoryBits,
-                                        const bool collidable, const float defaultFriction) {
-  list<b2Body*> bodies;
-
+void GameMap::createRectangles(const string& layerName, const short categoryBits,
+                               const bool collidable, const float defaultFriction) {
   for (const auto& rectObj : getObjects(layerName)) {
     const auto& valMap = rectObj.asValueMap();
     float x = valMap.at("x").asFloat();
@@ -237,26 +308,18 @@ list<b2Body*> GameMap::createRectangles(const string& layerName, const short cat
     float w = valMap.at("width").asFloat();
     float h = valMap.at("height").asFloat();
 
-    B2BodyBuilder bodyBuilder{_world};
-    b2Body* body = bodyBuilder.type(b2BodyType::b2_staticBody)
-      .position(x + w / 2, y + h / 2, kPpm)
-      .buildBody();
-
-    bodyBuilder.newRectangleFixture(w / 2, h / 2, kPpm)
-      .categoryBits(categoryBits)
-      .setSensor(!collidable)
-      .friction(defaultFriction)
-      .buildFixture();
-
-    bodies.emplace_back(body);
+    WorldStreamer::StaticBodyDesc desc;
+    desc.bounds.setRect(x, y, w, h);
+    desc.categoryBits = categoryBits;
+    desc.isCollidable = collidable;
+    desc.isPlatform = categoryBits == category_bits::kPlatform;
+    desc.friction = defaultFriction;
+    _worldStreamer->addStaticBody(std::move(desc));
   }
-
-  return bodies;
 }
 
-list<b2Body*> GameMap::createPolylines(const string& layerName, const short categoryBits,
-                                       const bool collidable, const float defaultFriction) {
-  list<b2Body*> bodies;
+void GameMap::createPolylines(const string& layerName, const short categoryBits,
+                              const bool collidable, const float defaultFriction) {
   float scaleFactor = Director::getInstance()->getContentScaleFactor();
 
   for (const auto& lineObj : getObjects(layerName)) {
@@ -282,21 +345,18 @@ list<b2Body*> GameMap::createPolylines(const string& layerName, const short cate
       }
     }
 
-    B2BodyBuilder bodyBuilder{_world};
-    b2Body* body = bodyBuilder.type(b2BodyType::b2_staticBody)
-      .position(0, 0, kPpm)
-      .buildBody();
-
-    bodyBuilder.newPolylineFixture(vertices.data(), valVec.size(), kPpm)
-      .categoryBits(categoryBits)
-      .setSensor(!collidable)
-      .friction(friction)
-      .buildFixture();
-
-    bodies.emplace_back(body);
+    WorldStreamer::StaticBodyDesc desc;
+    desc.bounds.setRect(vertices[0].x, vertices[0].y, 0, 0);
+    for (const auto& vertex : vertices) {
+      desc.bounds.merge(Rect{vertex.x, vertex.y, 0, 0});
+    }
+    desc.vertices = std::move(vertices);
+    desc.categoryBits = categoryBits;
+    desc.isCollidable = collidable;
+    desc.isPlatform = categoryBits == category_bits::kPlatform;
+    desc.friction = friction;
+    _worldStreamer->addStaticBody(std::move(desc));
   }
-
-  return bodies;
 }
 
 void GameMap::createTriggers() {
@@ -382,29 +442,17 @@ void GameMap::createNpcs() {
     const auto& valMap = rectObj.asValueMap();
     const float x = valMap.at("x").asFloat();
     const float y = valMap.at("y").asFloat();
-    const string npcJsonFilePath = valMap.at("json").asString();
-
-    if (!gmMgr->isNpcAllowedToSpawn(npcJsonFilePath)) {
-      continue;
-    }
 
-    auto npc = std::make_shared<Npc>(npcJsonFilePath);
-
-    const bool shouldShowDuringDawn = ax_util::extract<bool>(valMap, "shouldShowDuringDawn", true);
-    const bool shouldShowDuringDay = ax_util::extract<bool>(valMap, "shouldShowDuringDay", true);
-    const bool shouldShowDuringDusk = ax_util::extract<bool>(valMap, "shouldShowDuringDusk", true);
-    const bool shouldShowDuringNight = ax_util::extract<bool>(valMap, "shouldShowDuringNight", true);
-    npc->setShowDuringDawn(shouldShowDuringDawn);
-    npc->setShowDuringDay(shouldShowDuringDay);
-    npc->setShowDuringDusk(shouldShowDuringDusk);
-    npc->setShowDuringNight(shouldShowDuringNight);
-
-    const optional<bool> isFacingRight = ax_util::extract<bool>(valMap, "isFacingRight");
-    if (isFacingRight.has_value()) {
-      npc->setFacingRight(isFacingRight.value());
-    }
-
-    showDynamicActor(std::move(npc), x, y);
+    // Whether it is allowed to spawn is checked once its chunk is loaded.
+    WorldStreamer::NpcSnapshot snapshot;
+    snapshot.pos = {x, y};
+    snapshot.jsonFilePath = valMap.at("json").asString();
+    snapshot.isFacingRight = ax_util::extract<bool>(valMap, "isFacingRight");
+    snapshot.shouldShowDuringDawn = ax_util::extract<bool>(valMap, "shouldShowDuringDawn", true);
+    snapshot.shouldShowDuringDay = ax_util::extract<bool>(valMap, "shouldShowDuringDay", true);
+    snapshot.shouldShowDuringDusk = ax_util::extract<bool>(valMap, "shouldShowDuringDusk", true);
+    snapshot.shouldShowDuringNight = ax_util::extract<bool>(valMap, "shouldShowDuringNight", true);
+    _worldStreamer->addNpc(std::move(snapshot));
   }
 
   auto player = gmMgr->getPlayer();
@@ -423,6 +471,8 @@ void GameMap::createNpcs() {
         continue;
       }
       member->showOnMap(waitLoc.x * kPpm, waitLoc.y * kPpm);
+      // Party members aren't streamed, so keep the ground beneath them.
+      _worldStreamer->pin({waitLoc.x * kPpm, waitLoc.y * kPpm});
     }
   }
 }
@@ -435,8 +485,7 @@ void GameMap::createChests() {
     float y = valMap.at("y").asFloat();
     string items = valMap.at("items").asString();
 
-    auto chest = std::make_shared<Chest>(_tmxTiledMapFilePath, i, items);
-    showDynamicActor(std::move(chest), x, y);
+    _worldStreamer->addChest({{x, y}, i, std::move(items)});
   }
 }
 
@@ -468,11 +517,10 @@ void GameMap::createAnimatedObjects() {
     const string textureResDir = valMap.at("textureResDir").asString();
     const string framesName = valMap.at("framesName").asString();
     const float frameInterval = valMap.at("frameInterval").asFloat();
-    const float flipped = valMap.contains("flipped") ? valMap.at("flipped").asBool() : false;
-    const float zOrder = valMap.contains("zOrder") ? valMap.at("zOrder").asInt() : z_order::kStaticObjects;
+    const bool flipped = valMap.contains("flipped") ? valMap.at("flipped").asBool() : false;
+    const int zOrder = valMap.contains("zOrder") ? valMap.at("zOrder").asInt() : z_order::kStaticObjects;
 
-    auto staticObject = std::make_shared<StaticObject>(textureResDir, framesName, frameInterval, flipped, zOrder);
-    showStaticActor(std::move(staticObject), x, y);
+    _worldStreamer->addStaticObject({{x, y}, textureResDir, framesName, frameInterval, flipped, zOrder});
   }
 }
 
@@ -495,6 +543,17 @@ void GameMap::createParallaxBackground() {
   ax_util::addChildWithParentCameraMask(gmMgr->getParallaxLayer(), _parallaxBackground->getParallaxNode());
 }
 
+void GameMap::acquireTilesetTextures() const {
+  // The tile layers have already loaded their tilesets by now (or picked up the
+  // prefetched ones), this only lets TextureManager keep track of them.
+  for (auto child : _tmxTiledMap->getChildren()) {
+    const auto layer = dynamic_cast<TMXLayer*>(child);
+    if (layer && layer->getTileSet()) {
+      TextureManager::the().acquire(layer->getTileSet()->_sourceImage, TextureManager::Category::TILESET);
+    }
+  }
+}
+
 GameMap::Trigger::Trigger(const string& tmxMapFilePath,
                           const int triggerId,
                           const vector<string>& cmds,
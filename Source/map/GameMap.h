@@ -5,6 +5,7 @@
 
 #include <list>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -19,8 +20,10 @@
 #include "item/Item.h"
 #include "map/NavTiledMap.h"
 #include "map/Lighting.h"
+#include "map/MapPrefetcher.h"
 #include "map/ParallaxBackground.h"
 #include "map/PathFinder.h"
+#include "map/WorldStreamer.h"
 #include "util/Logger.h"
 
 namespace requiem {
@@ -146,9 +149,12 @@ class GameMap final {
   };
 
   GameMap(b2World* world, Lighting* lighting, const std::string& tmxMapFilePath);
+  GameMap(b2World* world, Lighting* lighting, const std::string& tmxMapFilePath,
+          MapPrefetcher::PrefetchedMap&& prefetchedMap);
   ~GameMap();
 
   void update(const float delta);
+  void cullStaticActors(const ax::Rect& cullingRect);
 
   void createObjects();
   std::unique_ptr<Player> createPlayer() const;
@@ -172,6 +178,10 @@ class GameMap final {
                       std::vector<std::string>&& execOnBegin,
                       std::vector<std::string>&& execOnPlayerKilled);
   void endBossFight(const bool isPlayerKilled);
+  // Ends the boss fight without running any of its commands, e.g., upon restoring a checkpoint.
+  void cancelBossFight();
+  // The player outlives this game map, so this must be called before it is destroyed.
+  void removeBossFightCallbacks();
 
   inline ax::TMXTiledMap* getTmxTiledMap() const { return _tmxTiledMap; }
   inline const std::string& getTmxTiledMapFilePath() const { return _tmxTiledMapFilePath; }
@@ -182,20 +192,22 @@ class GameMap final {
   inline bool isInBossFight() const { return _isInBossFight; }
   inline bool isGameOverOnPlayerKilled() const { return _isGameOverOnPlayerKilled; }
   inline const std::unordered_set<std::shared_ptr<DynamicActor>>& getDynamicActors() const { return _dynamicActors; }
-  inline const std::list<b2Body*> getTmxTiledMapPlatformBodies() const { return _tmxTiledMapPlatformBodies; }
+  inline const std::list<b2Body*>& getTmxTiledMapPlatformBodies() const { return _worldStreamer->getPlatformBodies(); }
+  inline const std::vector<std::unique_ptr<GameMap::Trigger>>& getTriggers() const { return _triggers; }
   inline const std::vector<std::unique_ptr<GameMap::Portal>>& getPortals() const { return _portals; };
   inline ParallaxBackground& getParallaxBackground() { return *_parallaxBackground; }
   inline const NavTiledMap& getNavTiledMap() const { return *_navTiledMap; }
+  inline WorldStreamer& getWorldStreamer() { return *_worldStreamer; }
 
   float getWidth() const;
   float getHeight() const;
 
  private:
   ax::ValueVector getObjects(const std::string& layerName);
-  std::list<b2Body*> createRectangles(const std::string& layerName, const short categoryBits,
-                                      const bool collidable, const float defaultFriction);
-  std::list<b2Body*> createPolylines(const std::string& layerName, const short categoryBits,
-                                     const bool collidable, const float defaultFriction);
+  void createRectangles(const std::string& layerName, const short categoryBits,
+                        const bool collidable, const float defaultFriction);
+  void createPolylines(const std::string& layerName, const short categoryBits,
+                       const bool collidable, const float defaultFriction);
 
   void createTriggers();
   void createPortals();
@@ -204,6 +216,7 @@ class GameMap final {
   void createLightSources();
   void createAnimatedObjects();
   void createParallaxBackground();
+  void acquireTilesetTextures() const;
 
   b2World* _world{};
   Lighting* _lighting{};
@@ -216,14 +229,18 @@ class GameMap final {
   bool _isInBossFight{};
   bool _isGameOverOnPlayerKilled{true};
   std::vector<std::string> _execOnPlayerKilled;
-  std::list<b2Body*> _tmxTiledMapBodies;
-  std::list<b2Body*> _tmxTiledMapPlatformBodies;
+  // The onKilled callbacks which end the boss fight.
+  std::weak_ptr<Character> _bossFightTarget;
+  uint64_t _bossFightTargetOnKilledCallbackId{};
+  uint64_t _playerOnKilledCallbackId{};
   std::unordered_set<std::shared_ptr<StaticActor>> _staticActors;
   std::unordered_set<std::shared_ptr<DynamicActor>> _dynamicActors;
   std::vector<std::unique_ptr<GameMap::Trigger>> _triggers;
   std::vector<std::unique_ptr<GameMap::Portal>> _portals;
   std::unique_ptr<ParallaxBackground> _parallaxBackground;
   std::unique_ptr<NavTiledMap> _navTiledMap;
+  std::unique_ptr<WorldStreamer> _worldStreamer;
+  std::optional<ax::Rect> _lastStaticActorsCullingRect;
 };
 
 template <typename ReturnType>
@@ -2,6 +2,7 @@
 
 #include "GameMapManager.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <system_error>
@@ -12,6 +13,7 @@
 #include "Audio.h"
 #include "CallbackManager.h"
 #include "Constants.h"
+#include "TextureManager.h"
 #include "character/Npc.h"
 #include "character/Player.h"
 #include "item/Equipment.h"
@@ -34,7 +36,14 @@ GameMapManager::GameMapManager(const b2Vec2& gravity)
       _layer{Layer::create()},
       _worldContactListener{std::make_unique<WorldContactListener>()},
       _world{std::make_unique<b2World>(gravity)},
-      _lighting{std::make_unique<Lighting>()} {
+      _lighting{std::make_unique<Lighting>()},
+      _spriteBatchManager{std::make_unique<SpriteBatchManager>(_layer)},
+      _npcAiScheduler{std::make_unique<NpcAiScheduler>()},
+      _damageQueue{std::make_unique<DamageQueue>()},
+      _volumeManager{std::make_unique<VolumeManager>()},
+      _checkpoint{std::make_unique<Checkpoint>()},
+      _projectilePool{std::make_unique<ProjectilePool>()},
+      _mapPrefetcher{std::make_unique<MapPrefetcher>()} {
   _world->SetAllowSleeping(true);
   _world->SetContinuousPhysics(true);
   _world->SetContactListener(_worldContactListener.get());
@@ -85,17 +94,38 @@ void GameMapManager::update(const float delta) {
   if (!_gameMap) {
     return;
   }
+
+  updateCullingRect();
+  _gameMap->cullStaticActors(_cullingRect);
   _gameMap->update(delta);
 
+  if (_player) {
+    _player->update(delta);
+    for (const auto& ally : _player->getAllies()) {
+      ally->update(delta);
+    }
+  }
+
+  // The Npcs updated above have only enqueued their decisions.
+  _npcAiScheduler->update();
+
+  // Tick the hazards which are currently occupied.
+  _volumeManager->update(delta);
+
+  // Resolve all the damage dealt in this frame, including
+  // the hits reported by the physics step.
+  _damageQueue->resolve();
+
+  // Nothing else in this frame refers to the npcs which are turned into snapshots here.
+  streamChunks();
+  _mapPrefetcher->update();
+
   if (!_player) {
     return;
   }
-  _player->update(delta);
-  for (const auto& ally : _player->getAllies()) {
-    ally->update(delta);
-  }
 
   _lighting->update();
+  _spriteBatchManager->update();
 }
 
 void GameMapManager::loadGameMap(const string& tmxMapFilePath,
@@ -110,6 +140,12 @@ void GameMapManager::loadGameMap(const string& tmxMapFilePath,
       CallFunc::create([this, shade, tmxMapFilePath, afterLoadingGameMap]() {
         doLoadGameMap(tmxMapFilePath);
         afterLoadingGameMap(_gameMap.get());
+        streamChunks(/*shouldLoadAllInRange=*/true);
+        // Now that the chunks around the player have acquired the textures they need,
+        // the textures that are only used by the previous maps can be evicted.
+        TextureManager::the().evictUntilWithinBudget();
+        prefetchPortalDestinations();
+        _checkpoint->capture();
         _areNpcsAllowedToAct = true;
         _isLoadingGameMap = false;
       }),
@@ -118,28 +154,74 @@ void GameMapManager::loadGameMap(const string& tmxMapFilePath,
   ));
 }
 
+bool GameMapManager::retryFromCheckpoint(const float fadeInSec, const float fadeOutSec) {
+  if (!_gameMap || !_checkpoint->isCaptured() ||
+      _checkpoint->getTmxMapFilePath() != _gameMap->getTmxTiledMapFilePath()) {
+    return false;
+  }
+
+  _isLoadingGameMap = true;
+  setNpcsAllowedToAct(false);
+
+  auto shade = SceneManager::the().getCurrentScene<GameScene>()->getShade();
+  shade->getImageView()->runAction(Sequence::create(
+      FadeIn::create(fadeInSec),
+      CallFunc::create([this]() {
+        if (!_checkpoint->restore()) {
+          SceneManager::the().getCurrentScene<GameScene>()->setActive(false);
+          return;
+        }
+        Audio::the().playBgm(_gameMap->getBgmFilePath());
+        streamChunks(/*shouldLoadAllInRange=*/true);
+        _areNpcsAllowedToAct = true;
+        _isLoadingGameMap = false;
+      }),
+      FadeOut::create(fadeOutSec),
+      nullptr
+  ));
+  return true;
+}
+
 void GameMapManager::destroyGameMap() {
   setNpcsAllowedToAct(false);
 
   if (_player) {
-    for (auto ally : _player->getAllies()) {
+    // The killed allies leave the party in beforeMapChanged(), so iterate over a copy.
+    const AllyView allyView = _player->getAllies();
+    const vector<Character*> allies{allyView.begin(), allyView.end()};
+    for (auto ally : allies) {
       ally->beforeMapChanged();
     }
   }
 
   if (_gameMap) {
+    _gameMap->removeBossFightCallbacks();
     _parallaxLayer->removeAllChildren();
     _layer->removeChild(_gameMap->getTmxTiledMap());
     _gameMap.reset();
   }
+
+  // The pooled projectiles hold onto their sprites, so release them first.
+  _projectilePool->clear();
+  _spriteBatchManager->removeEmptySpriteBatchNodes();
+  _npcAiScheduler->clear();
+  _damageQueue->clear();
+  _volumeManager->clear();
+  _checkpoint->clear();
 }
 
 void GameMapManager::doLoadGameMap(const string& tmxMapFilePath) {
   const string oldBgmFilePath = (_gameMap) ? _gameMap->getBgmFilePath() : "";
 
   destroyGameMap();
-  _gameMap = std::make_unique<GameMap>(_world.get(), _lighting.get(), tmxMapFilePath);
+  TextureManager::the().beginGameMap(tmxMapFilePath);
+  if (auto prefetchedMap = _mapPrefetcher->take(tmxMapFilePath)) {
+    _gameMap = std::make_unique<GameMap>(_world.get(), _lighting.get(), tmxMapFilePath, std::move(*prefetchedMap));
+  } else {
+    _gameMap = std::make_unique<GameMap>(_world.get(), _lighting.get(), tmxMapFilePath);
+  }
   _gameMap->createObjects();
+  registerVolumes();
   ax_util::addChildWithParentCameraMask(_layer, _gameMap->getTmxTiledMap(), z_order::kTmxTiledMap);
 
   if (!_player) {
@@ -148,20 +230,65 @@ void GameMapManager::doLoadGameMap(const string& tmxMapFilePath) {
   }
 
   _lighting->setGameMap(_gameMap.get());
-  _lighting->setDarknessOverlaySize(_gameMap->getWidth(), _gameMap->getHeight());
+  _lighting->resizeDarknessOverlay();
 
   if (oldBgmFilePath != _gameMap->getBgmFilePath()) {
     Audio::the().playBgm(_gameMap->getBgmFilePath());
   }
 }
 
-bool GameMapManager::rayCast(const b2Vec2& src, const b2Vec2& dst, const short categoryBitsToStop,
-                             const bool shouldDrawLine) const {
-  if (shouldDrawLine) {
-    auto draw = ax::DrawNode::create();
-    draw->drawLine(Point{src.x * kPpm, src.y * kPpm}, Point{dst.x * kPpm, dst.y * kPpm}, ax::Color4F::WHITE);
-    _layer->addChild(draw, z_order::kHud);
+void GameMapManager::streamChunks(const bool shouldLoadAllInRange) {
+  if (!_player || !_player->getBody()) {
+    return;
+  }
+
+  const b2Vec2& playerPos = _player->getBody()->GetPosition();
+  _gameMap->getWorldStreamer().update({playerPos.x * kPpm, playerPos.y * kPpm}, shouldLoadAllInRange);
+}
+
+void GameMapManager::prefetchPortalDestinations() {
+  if (!_gameMap || !_player) {
+    return;
+  }
+
+  vector<string> tmxMapFilePaths;
+  for (const auto& portal : _gameMap->getPortals()) {
+    const string& destTmxMapFilePath = portal->getDestTmxMapFilePath();
+    if (destTmxMapFilePath == _gameMap->getTmxTiledMapFilePath() ||
+        (portal->isLocked() && !portal->canBeUnlockedBy(_player.get())) ||
+        std::find(tmxMapFilePaths.begin(), tmxMapFilePaths.end(), destTmxMapFilePath) != tmxMapFilePaths.end()) {
+      continue;
+    }
+    tmxMapFilePaths.push_back(destTmxMapFilePath);
+  }
+
+  _mapPrefetcher->prefetch(tmxMapFilePaths);
+}
+
+void GameMapManager::updateCullingRect() {
+  // The camera is moved at the end of the previous frame, which the margin covers.
+  const Camera* camera = SceneManager::the().getCurrentScene<GameScene>()->getGameCamera();
+  const Size& winSize = Director::getInstance()->getWinSize();
+  _cullingRect.setRect(camera->getPositionX() - winSize.width / 2 - kCullingMargin,
+                       camera->getPositionY() - winSize.height / 2 - kCullingMargin,
+                       winSize.width + kCullingMargin * 2,
+                       winSize.height + kCullingMargin * 2);
+}
+
+void GameMapManager::registerVolumes() {
+  for (const auto& trigger : _gameMap->getTriggers()) {
+    const auto type = (trigger->getDamage()) ? VolumeManager::Type::HAZARD : VolumeManager::Type::TRIGGER;
+    _volumeManager->addVolume(trigger.get(), type, trigger->getDamage());
   }
+  for (const auto& portal : _gameMap->getPortals()) {
+    _volumeManager->addVolume(portal.get(), VolumeManager::Type::PORTAL);
+  }
+}
+
+bool GameMapManager::rayCast(const b2Vec2& src, const b2Vec2& dst, const short categoryBitsToStop) const {
+  auto debugOverlay = SceneManager::the().getCurrentScene<GameScene>()->getDebugOverlay();
+  debugOverlay->drawLine(DebugOverlay::Category::RAYCAST,
+                         {src.x * kPpm, src.y * kPpm}, {dst.x * kPpm, dst.y * kPpm}, Color4F::WHITE);
 
   B2RayCastCallback cb{[categoryBitsToStop](b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction) -> float {
     if (fixture->GetFilterData().categoryBits & categoryBitsToStop) {
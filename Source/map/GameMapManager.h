@@ -15,16 +15,24 @@
 
 #include "Controllable.h"
 #include "character/Character.h"
+#include "character/NpcAiScheduler.h"
 #include "character/Player.h"
+#include "combat/DamageQueue.h"
+#include "gameplay/Checkpoint.h"
 #include "item/Item.h"
 #include "map/GameMap.h"
 #include "map/Lighting.h"
+#include "map/MapPrefetcher.h"
+#include "map/SpriteBatchManager.h"
+#include "map/VolumeManager.h"
 #include "map/WorldContactListener.h"
+#include "skill/ProjectilePool.h"
 #include "ui/Shade.h"
 
 namespace requiem {
 
 class GameMapManager final {
+  friend class Checkpoint;
   friend class GameState;
 
  public:
@@ -40,8 +48,12 @@ class GameMapManager final {
                    const float fadeInSec = Shade::kFadeInSec,
                    const float fadeOutSec = Shade::kFadeOutSec);
   void destroyGameMap();
-  bool rayCast(const b2Vec2& src, const b2Vec2& dst, const short categoryBitsToStop,
-               const bool shouldDrawLine = false) const;
+
+  // Fades the screen out, restores the checkpoint of the current game map, and fades it back in.
+  // @return: whether there's a checkpoint of the current game map to retry from.
+  bool retryFromCheckpoint(const float fadeInSec = Shade::kFadeInSec,
+                           const float fadeOutSec = Shade::kFadeOutSec);
+  bool rayCast(const b2Vec2& src, const b2Vec2& dst, const short categoryBitsToStop) const;
 
   std::optional<std::string> getTmxMapFilePathByMapAlias(const std::string& mapAlias) const;
 
@@ -69,16 +81,34 @@ class GameMapManager final {
   void setTriggerActivated(const std::string& tmxMapFilePath,
                            const int targetTriggerId);
 
+  // The area around the camera in which actors are animated. The cosmetic
+  // updates of the actors outside of it are paused until they're back in it.
+  inline const ax::Rect& getCullingRect() const { return _cullingRect; }
+  inline bool isInCullingRect(const ax::Vec2& pos) const { return _cullingRect.containsPoint(pos); }
+
   inline ax::Layer* getParallaxLayer() const { return _parallaxLayer; }
   inline ax::Layer* getLayer() const { return _layer; }
   inline b2World* getWorld() const { return _world.get(); }
   inline Lighting* getLighting() const { return _lighting.get(); }
+  inline SpriteBatchManager* getSpriteBatchManager() const { return _spriteBatchManager.get(); }
+  inline NpcAiScheduler* getNpcAiScheduler() const { return _npcAiScheduler.get(); }
+  inline DamageQueue* getDamageQueue() const { return _damageQueue.get(); }
+  inline VolumeManager* getVolumeManager() const { return _volumeManager.get(); }
+  inline Checkpoint* getCheckpoint() const { return _checkpoint.get(); }
+  inline ProjectilePool* getProjectilePool() const { return _projectilePool.get(); }
+  inline MapPrefetcher* getMapPrefetcher() const { return _mapPrefetcher.get(); }
   inline GameMap* getGameMap() const { return _gameMap.get(); }
   inline Player* getPlayer() const { return _player.get(); }
 
+  static inline constexpr float kCullingMargin = 256.0f;
+
  private:
   bool initMapAliases();
   void doLoadGameMap(const std::string& tmxMapFilePath);
+  void streamChunks(const bool shouldLoadAllInRange = false);
+  void prefetchPortalDestinations();
+  void updateCullingRect();
+  void registerVolumes();
   std::string getOpenableObjectQueryKey(const std::string& tmxMapFilePath,
                                         const GameMap::OpenableObjectType type,
                                         const int targetObjectId) const;
@@ -90,9 +120,17 @@ class GameMapManager final {
   std::unique_ptr<WorldContactListener> _worldContactListener;
   std::unique_ptr<b2World> _world;
   std::unique_ptr<Lighting> _lighting;
+  std::unique_ptr<SpriteBatchManager> _spriteBatchManager;
+  std::unique_ptr<NpcAiScheduler> _npcAiScheduler;
+  std::unique_ptr<DamageQueue> _damageQueue;
+  std::unique_ptr<VolumeManager> _volumeManager;
+  std::unique_ptr<Checkpoint> _checkpoint;
+  std::unique_ptr<ProjectilePool> _projectilePool;
+  std::unique_ptr<MapPrefetcher> _mapPrefetcher;
   std::unique_ptr<GameMap> _gameMap;
   std::unique_ptr<Player> _player;
   std::unordered_map<std::string, std::string> _mapAliasToTmxMapFilePath;
+  ax::Rect _cullingRect;
 
   bool _isLoadingGameMap{};
   bool _areNpcsAllowedToAct{true};
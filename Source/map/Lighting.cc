@@ -2,15 +2,18 @@
 
 #include "Lighting.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "Assets.h"
 #include "Constants.h"
+#include "TextureManager.h"
 #include "map/GameMap.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
 #include "util/Logger.h"
 #include "util/AxUtil.h"
+#include "util/StringUtil.h"
 
 using namespace std;
 using namespace requiem::assets;
@@ -18,6 +21,13 @@ USING_NS_AX;
 
 namespace requiem {
 
+namespace {
+
+// The overlay is an RGBA8 texture, so smaller changes than this aren't visible.
+constexpr float kAmbientLightLevelEpsilon = 1.0f / 255;
+
+}  // namespace
+
 Lighting::Lighting() : _layer{Layer::create()} {}
 
 void Lighting::update() {
@@ -25,7 +35,16 @@ void Lighting::update() {
   const float brightnessPercentage = getBrightnessPercentage(inGameTime);
   updateAmbientLightLevel(inGameTime, brightnessPercentage);
   updateParallaxLightLevel(inGameTime, brightnessPercentage);
-  updateLightSources();
+  updateDarknessOverlayRect();
+  updateDynamicLightSources();
+
+  _numUpdates++;
+  if (_isLightmapDirty) {
+    bakeLightmap();
+  }
+  if (_isDirty) {
+    renderDarknessOverlay();
+  }
 }
 
 float Lighting::getBrightnessPercentage(const InGameTime* inGameTime) const {
@@ -99,69 +118,216 @@ void Lighting::updateParallaxLightLevel(const InGameTime* inGameTime, const floa
   }
 }
 
-void Lighting::updateLightSources() {
+void Lighting::updateDarknessOverlayRect() {
+  if (!_darknessOverlay) {
+    return;
+  }
+
+  const Camera* camera = SceneManager::the().getCurrentScene<GameScene>()->getGameCamera();
+  const Size& winSize = Director::getInstance()->getWinSize();
+  const Rect viewport{camera->getPosition() - Vec2{winSize.width / 2, winSize.height / 2}, winSize};
+
+  // The overlay stays where it is as long as it still covers the whole viewport.
+  if (!_isDirty &&
+      _darknessOverlayRect.containsPoint(viewport.origin) &&
+      _darknessOverlayRect.containsPoint({viewport.getMaxX(), viewport.getMaxY()})) {
+    return;
+  }
+
+  _darknessOverlayRect.origin.set(std::floor(viewport.origin.x - kDarknessOverlayMargin),
+                                  std::floor(viewport.origin.y - kDarknessOverlayMargin));
+  _darknessOverlay->setPosition(_darknessOverlayRect.getMidX(), _darknessOverlayRect.getMidY());
+  _isDirty = true;
+}
+
+void Lighting::updateDynamicLightSources() {
+  for (auto& lightSource : _dynamicLightSources) {
+    const b2Vec2& b2bodyPos = lightSource.dynamicActor->getBody()->GetPosition();
+    const Vec2 pos{b2bodyPos.x * kPpm, b2bodyPos.y * kPpm};
+    if (pos == lightSource.lastPos) {
+      continue;
+    }
+
+    if (getLightSourceRect(pos, lightSource.sprite).intersectsRect(_darknessOverlayRect) ||
+        getLightSourceRect(lightSource.lastPos, lightSource.sprite).intersectsRect(_darknessOverlayRect)) {
+      _isDirty = true;
+    }
+    lightSource.lastPos = pos;
+  }
+}
+
+void Lighting::renderDarknessOverlay() {
+  if (!_darknessOverlay) {
+    return;
+  }
+
+  const Vec2& origin = _darknessOverlayRect.origin;
+  _numRenderedLightSources = 0;
+
   _darknessOverlay->beginWithClear(0, 0, 0, 1.f - _ambientLightLevel);
 
-  for (const auto& [dynamicActor, lightSourceSprite] : _dynamicLightSources) {
-    lightSourceSprite->setPosition(dynamicActor->getBody()->GetPosition().x * kPpm, dynamicActor->getBody()->GetPosition().y * kPpm);
+  for (const auto& [_, lightSourceSprite, pos] : _dynamicLightSources) {
+    if (!getLightSourceRect(pos, lightSourceSprite).intersectsRect(_darknessOverlayRect)) {
+      continue;
+    }
+    lightSourceSprite->setPosition(pos - origin);
     lightSourceSprite->visit();
+    _numRenderedLightSources++;
+  }
+
+  if (_lightmap) {
+    Sprite* lightmapSprite = _lightmap->getSprite();
+    lightmapSprite->setPosition(-origin);
+    lightmapSprite->visit();
+  }
+
+  _darknessOverlay->end();
+
+  _isDirty = false;
+  _numRenders++;
+}
+
+void Lighting::bakeLightmap() {
+  _isLightmapDirty = false;
+  if (!_gameMap || _staticLightSources.empty()) {
+    AX_SAFE_RELEASE_NULL(_lightmap);
+    _isDirty = true;
+    return;
+  }
+
+  // Light sources are soft radial gradients, so the lightmap can be downscaled
+  // without visible loss, but it must still fit into a single texture.
+  const float maxTextureSize = Configuration::getInstance()->getMaxTextureSize();
+  const float scale = std::min({kLightmapScale,
+                                maxTextureSize / _gameMap->getWidth(),
+                                maxTextureSize / _gameMap->getHeight()});
+  const float width = std::ceil(_gameMap->getWidth() * scale);
+  const float height = std::ceil(_gameMap->getHeight() * scale);
+
+  if (!_lightmap ||
+      _lightmap->getSprite()->getContentSize().width != width ||
+      _lightmap->getSprite()->getContentSize().height != height) {
+    AX_SAFE_RELEASE_NULL(_lightmap);
+    _lightmap = RenderTexture::create(width, height, backend::PixelFormat::RGBA8);
+    _lightmap->retain();
   }
 
+  // Each light source multiplies the lightmap's alpha by (1 - its alpha),
+  // and the lightmap's sprite then multiplies the overlay's alpha by that.
+  // The product of the light sources doesn't depend on the ambient light level,
+  // so the lightmap stays valid across all times of day.
+  _lightmap->beginWithClear(0, 0, 0, 1.f);
   for (const auto& [pos, lightSourceSprite] : _staticLightSources) {
-    lightSourceSprite->setPosition(pos.first, pos.second);
+    lightSourceSprite->setScale(scale);
+    lightSourceSprite->setPosition(pos * scale);
     lightSourceSprite->visit();
   }
+  _lightmap->end();
 
-  _darknessOverlay->end();
+  Sprite* lightmapSprite = _lightmap->getSprite();
+  lightmapSprite->setAnchorPoint(Vec2::ZERO);
+  lightmapSprite->setScale(1.0f / scale);
+  lightmapSprite->setBlendFunc({backend::BlendFactor::ZERO, backend::BlendFactor::SRC_ALPHA});
+
+  _isDirty = true;
+  _numBakes++;
 }
 
 void Lighting::addLightSource(DynamicActor* dynamicActor) {
-  Sprite* lightSourceSprite = Sprite::create(kLightSource.c_str());
-  lightSourceSprite->setBlendFunc({backend::BlendFactor::ZERO, backend::BlendFactor::ONE_MINUS_SRC_ALPHA});
-  lightSourceSprite->retain();
-
-  _dynamicLightSources.push_back({dynamicActor, lightSourceSprite});
+  const b2Vec2& b2bodyPos = dynamicActor->getBody()->GetPosition();
+  Sprite* lightSourceSprite = createLightSourceSprite();
+  _dynamicLightSources.push_back({dynamicActor, lightSourceSprite, {b2bodyPos.x * kPpm, b2bodyPos.y * kPpm}});
+  _isDirty = true;
 }
 
 void Lighting::addLightSource(StaticActor* staticActor) {
-  Sprite* lightSourceSprite = Sprite::create(kLightSource.c_str());
-  lightSourceSprite->setBlendFunc({backend::BlendFactor::ZERO, backend::BlendFactor::ONE_MINUS_SRC_ALPHA});
-  lightSourceSprite->retain();
-
-  const float x = staticActor->getBodySprite()->getPosition().x;
-  const float y = staticActor->getBodySprite()->getPosition().y;
-  _staticLightSources.push_back({{x, y}, lightSourceSprite});
+  addStaticLightSource(staticActor->getBodySprite()->getPosition(), createLightSourceSprite());
 }
 
 void Lighting::addLightSource(const float x, const float y) {
-  Sprite* lightSourceSprite = Sprite::create(kLightSource.c_str());
-  lightSourceSprite->setBlendFunc({backend::BlendFactor::ZERO, backend::BlendFactor::ONE_MINUS_SRC_ALPHA});
-  lightSourceSprite->retain();
-
-  _staticLightSources.push_back({{x, y}, lightSourceSprite});
+  addStaticLightSource({x, y}, createLightSourceSprite());
 }
 
-void Lighting::setDarknessOverlaySize(const float width, const float height) {
+void Lighting::resizeDarknessOverlay() {
+  const Size& winSize = Director::getInstance()->getWinSize();
+  const Size size{winSize.width + kDarknessOverlayMargin * 2, winSize.height + kDarknessOverlayMargin * 2};
+  _isDirty = true;
+
+  if (_darknessOverlay && _darknessOverlayRect.size.equals(size)) {
+    return;
+  }
+
   _layer->removeChild(_darknessOverlay);
 
-  _darknessOverlay = RenderTexture::create(width, height, backend::PixelFormat::RGBA8);
+  _darknessOverlay = RenderTexture::create(size.width, size.height, backend::PixelFormat::RGBA8);
   _darknessOverlay->setAnchorPoint({0.5, 0.5});
-  _darknessOverlay->setPosition(width / 2, height / 2);
+  _darknessOverlay->setPosition(size.width / 2, size.height / 2);
   _darknessOverlay->getSprite()->setCameraMask(_layer->getCameraMask());
+  _darknessOverlayRect.setRect(0, 0, size.width, size.height);
 
   ax_util::addChildWithParentCameraMask(_layer, _darknessOverlay);
 }
 
+void Lighting::setAmbientLightLevel(const float level) {
+  if (std::abs(level - _ambientLightLevel) < kAmbientLightLevelEpsilon) {
+    return;
+  }
+
+  _ambientLightLevel = level;
+  _isDirty = true;
+}
+
 void Lighting::clear() {
-  for (const auto& [_, lightSourceSprite] : _dynamicLightSources) {
-    lightSourceSprite->release();
+  for (const auto& lightSource : _dynamicLightSources) {
+    lightSource.sprite->release();
   }
   _dynamicLightSources.clear();
 
-  for (const auto& [_, lightSourceSprite] : _staticLightSources) {
-    lightSourceSprite->release();
+  for (const auto& lightSource : _staticLightSources) {
+    lightSource.sprite->release();
   }
   _staticLightSources.clear();
+
+  AX_SAFE_RELEASE_NULL(_lightmap);
+  _isLightmapDirty = true;
+}
+
+vector<string> Lighting::getReport() const {
+  const float renderedPercentage = _numUpdates > 0 ? 100.0f * _numRenders / _numUpdates : 0;
+
+  return {
+    string_util::format("darkness overlay: %.0fx%.0f at (%.0f, %.0f)",
+                        _darknessOverlayRect.size.width, _darknessOverlayRect.size.height,
+                        _darknessOverlayRect.origin.x, _darknessOverlayRect.origin.y),
+    string_util::format("light sources: %d static, %d dynamic (%d rendered)",
+                        static_cast<int>(_staticLightSources.size()),
+                        static_cast<int>(_dynamicLightSources.size()),
+                        _numRenderedLightSources),
+    string_util::format("lightmap: %.0fx%.0f, baked %d time(s)",
+                        _lightmap ? _lightmap->getSprite()->getContentSize().width : 0,
+                        _lightmap ? _lightmap->getSprite()->getContentSize().height : 0,
+                        _numBakes),
+    string_util::format("overlay renders: %d/%d updates (%.1f%%)",
+                        _numRenders, _numUpdates, renderedPercentage),
+  };
+}
+
+Sprite* Lighting::createLightSourceSprite() const {
+  TextureManager::the().acquire(kLightSource, TextureManager::Category::LIGHTING);
+  Sprite* lightSourceSprite = Sprite::create(kLightSource.c_str());
+  lightSourceSprite->setBlendFunc({backend::BlendFactor::ZERO, backend::BlendFactor::ONE_MINUS_SRC_ALPHA});
+  lightSourceSprite->retain();
+  return lightSourceSprite;
+}
+
+void Lighting::addStaticLightSource(const Vec2& pos, Sprite* sprite) {
+  _staticLightSources.push_back({pos, sprite});
+  _isLightmapDirty = true;
+}
+
+Rect Lighting::getLightSourceRect(const Vec2& pos, const Sprite* sprite) const {
+  const float halfExtent = std::max(sprite->getContentSize().width, sprite->getContentSize().height) / 2;
+  return {pos.x - halfExtent, pos.y - halfExtent, halfExtent * 2, halfExtent * 2};
 }
 
 }  // namespace requiem
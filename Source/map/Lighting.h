@@ -4,6 +4,8 @@
 #define REQUIEM_MAP_LIGHTING_H_
 
 #include <list>
+#include <string>
+#include <vector>
 
 #include <axmol.h>
 
@@ -15,6 +17,15 @@ namespace requiem {
 
 class GameMap;
 
+// Renders the darkness overlay of the current game map.
+//
+// The overlay covers the viewport plus a margin on each side, and only follows
+// the camera once the viewport has left it. The static light sources are baked
+// into a downscaled lightmap of the whole game map once per game map, so that
+// rendering the overlay only costs one draw for the lightmap plus one for each
+// dynamic light source in view. The overlay is only re-rendered when it has
+// been moved, a light source has been added or moved, or the ambient light
+// level changed.
 class Lighting final {
  public:
   Lighting();
@@ -24,26 +35,58 @@ class Lighting final {
   void addLightSource(DynamicActor* dynamicActor);
   void addLightSource(StaticActor* staticActor);
   void addLightSource(const float x, const float y);
-  void setDarknessOverlaySize(const float width, const float height);
+  void resizeDarknessOverlay();
+  void setAmbientLightLevel(const float level);
   void clear();
 
+  std::vector<std::string> getReport() const;
+
   inline ax::Layer* getLayer() const { return _layer; }
-  inline void setGameMap(GameMap* gameMap) { _gameMap = gameMap; }
-  inline void setAmbientLightLevel(const float level) { _ambientLightLevel = level; }
+  inline void setGameMap(GameMap* gameMap) { _gameMap = gameMap; _isLightmapDirty = true; }
+
+  static inline constexpr float kDarknessOverlayMargin = 128.0f;
+  static inline constexpr float kLightmapScale = 0.25f;
 
  private:
+  struct DynamicLightSource {
+    DynamicActor* dynamicActor;
+    ax::Sprite* sprite;
+    ax::Vec2 lastPos;
+  };
+
+  struct StaticLightSource {
+    ax::Vec2 pos;
+    ax::Sprite* sprite;
+  };
+
   float getBrightnessPercentage(const InGameTime* inGameTime) const;
   void updateAmbientLightLevel(const InGameTime* inGameTime, const float brightnessPercentage);
   void updateParallaxLightLevel(const InGameTime* inGameTime, const float brightnessPercentage);
-  void updateLightSources();
+  void updateDarknessOverlayRect();
+  void updateDynamicLightSources();
+  void bakeLightmap();
+  void renderDarknessOverlay();
+
+  ax::Sprite* createLightSourceSprite() const;
+  void addStaticLightSource(const ax::Vec2& pos, ax::Sprite* sprite);
+  ax::Rect getLightSourceRect(const ax::Vec2& pos, const ax::Sprite* sprite) const;
 
   ax::Layer* _layer{};
   ax::RenderTexture* _darknessOverlay{};
-  std::list<std::pair<DynamicActor*, ax::Sprite*>> _dynamicLightSources;
-  std::list<std::pair<std::pair<float, float>, ax::Sprite*>> _staticLightSources;
+  ax::Rect _darknessOverlayRect;
+  std::list<DynamicLightSource> _dynamicLightSources;
+  std::vector<StaticLightSource> _staticLightSources;
+  ax::RenderTexture* _lightmap{};
 
   GameMap* _gameMap{};
   float _ambientLightLevel{0.3f};
+  bool _isDirty{true};
+  bool _isLightmapDirty{true};
+
+  int _numUpdates{};
+  int _numRenders{};
+  int _numBakes{};
+  int _numRenderedLightSources{};
 };
 
 }  // namespace requiem
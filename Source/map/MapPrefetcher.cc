@@ -0,0 +1,179 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#include "MapPrefetcher.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "TextureManager.h"
+#include "map/ParallaxBackground.h"
+#include "util/Logger.h"
+#include "util/StringUtil.h"
+
+using namespace std;
+USING_NS_AX;
+
+namespace requiem {
+
+void MapPrefetcher::update() {
+  for (auto it = _jobs.begin(); it != _jobs.end();) {
+    Job& job = it->second;
+    if (job.isDone || job.future.wait_for(chrono::seconds::zero()) != future_status::ready) {
+      it++;
+      continue;
+    }
+
+    job.prefetchedMap = job.future.get();
+    job.isDone = true;
+    if (!job.prefetchedMap) {
+      VGLOG(LOG_ERR, "Failed to prefetch game map [%s].", it->first.c_str());
+    }
+    if (!job.prefetchedMap || !job.isWanted) {
+      it = _jobs.erase(it);
+      continue;
+    }
+
+    onPrepared(job);
+    it++;
+  }
+}
+
+void MapPrefetcher::prefetch(const vector<string>& tmxMapFilePaths) {
+  const auto end = tmxMapFilePaths.begin() + std::min<size_t>(tmxMapFilePaths.size(), kMaxNumPrefetchedMaps);
+
+  // The destructor of a std::future from std::async() blocks until the job has finished,
+  // so the unwanted ones which are still being prepared are dropped in update() instead.
+  for (auto it = _jobs.begin(); it != _jobs.end();) {
+    Job& job = it->second;
+    job.isWanted = std::find(tmxMapFilePaths.begin(), end, it->first) != end;
+    it = (!job.isWanted && job.isDone) ? _jobs.erase(it) : std::next(it);
+  }
+
+  for (auto pathIt = tmxMapFilePaths.begin(); pathIt != end; pathIt++) {
+    const string& tmxMapFilePath = *pathIt;
+    if (_jobs.contains(tmxMapFilePath)) {
+      continue;
+    }
+
+    // FileUtils' path cache isn't thread-safe, so the paths are resolved here.
+    const string fullPath = FileUtils::getInstance()->fullPathForFilename(tmxMapFilePath);
+    if (fullPath.empty()) {
+      VGLOG(LOG_ERR, "Failed to prefetch game map [%s], no such file.", tmxMapFilePath.c_str());
+      continue;
+    }
+    const string resourcePath = fullPath.substr(0, fullPath.find_last_of('/'));
+
+    Job& job = _jobs[tmxMapFilePath];
+    job.future = std::async(std::launch::async, &MapPrefetcher::prepare, fullPath, resourcePath);
+  }
+}
+
+optional<MapPrefetcher::PrefetchedMap> MapPrefetcher::take(const string& tmxMapFilePath) {
+  auto it = _jobs.find(tmxMapFilePath);
+  if (it == _jobs.end()) {
+    _numMisses++;
+    return std::nullopt;
+  }
+
+  // It has been read for the most part anyway, so waiting for it
+  // costs less than starting all over again.
+  Job& job = it->second;
+  if (!job.isDone) {
+    job.prefetchedMap = job.future.get();
+    job.isDone = true;
+  }
+
+  optional<PrefetchedMap> prefetchedMap = std::move(job.prefetchedMap);
+  _jobs.erase(it);
+
+  if (!prefetchedMap) {
+    _numMisses++;
+    return std::nullopt;
+  }
+  _numHits++;
+  return prefetchedMap;
+}
+
+vector<string> MapPrefetcher::getReport() const {
+  int numReady = 0;
+  int numPending = 0;
+  for (const auto& [_, job] : _jobs) {
+    if (job.isDone) {
+      numReady++;
+    } else {
+      numPending++;
+    }
+  }
+
+  return {
+    string_util::format("prefetched maps: %d ready, %d pending", numReady, numPending),
+    string_util::format("hits: %d, misses: %d", static_cast<int>(_numHits), static_cast<int>(_numMisses)),
+  };
+}
+
+optional<MapPrefetcher::PrefetchedMap> MapPrefetcher::prepare(const string& fullPath,
+                                                              const string& resourcePath) {
+  const string tmxXml = FileUtils::getInstance()->getStringFromFile(fullPath);
+  if (tmxXml.empty()) {
+    return std::nullopt;
+  }
+
+  // TMXMapInfo::create() autoreleases the map info, and the autorelease pool
+  // belongs to the main thread, so it is created by hand instead and handed
+  // over to the main thread, which builds the game map from it.
+  PrefetchedMap prefetchedMap;
+  TMXMapInfo* mapInfo = new TMXMapInfo();
+  prefetchedMap.mapInfo = mapInfo;
+  mapInfo->release();  // now only owned by `prefetchedMap`.
+  if (!mapInfo->initWithXML(tmxXml, resourcePath)) {
+    return std::nullopt;
+  }
+
+  const auto& tilesets = mapInfo->getTilesets();
+  for (const auto tileset : tilesets) {
+    prefetchedMap.tilesetTextureFilePaths.push_back(tileset->_sourceImage);
+  }
+
+  const ValueMap& properties = mapInfo->getProperties();
+  if (const auto it = properties.find("parallaxBackground"); it != properties.end()) {
+    for (const auto& bgPath : ParallaxBackground::getLayerFilePaths(it->second.asString())) {
+      prefetchedMap.parallaxTextureFilePaths.push_back(bgPath.native());
+    }
+  }
+
+  for (const auto layerInfo : mapInfo->getLayers()) {
+    // TMXTiledMap skips the invisible layers.
+    if (layerInfo->_name != "Bitmap" || !layerInfo->_visible) {
+      continue;
+    }
+
+    // Like TMXTiledMap, a layer uses the last tileset which
+    // has a first gid no greater than any of its gids.
+    const int numTiles = static_cast<int>(layerInfo->_layerSize.width * layerInfo->_layerSize.height);
+    uint32_t maxGid = 0;
+    for (int i = 0; i < numTiles; i++) {
+      maxGid = std::max(maxGid, layerInfo->_tiles[i] & kTMXFlippedMask);
+    }
+    for (auto tilesetIt = tilesets.rbegin(); tilesetIt != tilesets.rend(); tilesetIt++) {
+      if (maxGid && maxGid >= static_cast<uint32_t>((*tilesetIt)->_firstGid)) {
+        prefetchedMap.navTiles = NavTiledMap::buildNavTiles(layerInfo->_layerSize, layerInfo->_tiles,
+                                                            (*tilesetIt)->_firstGid);
+        break;
+      }
+    }
+    break;
+  }
+
+  return prefetchedMap;
+}
+
+void MapPrefetcher::onPrepared(Job& job) {
+  for (const auto& textureFilePath : job.prefetchedMap->tilesetTextureFilePaths) {
+    TextureManager::the().prefetch(textureFilePath, TextureManager::Category::TILESET);
+  }
+  for (const auto& textureFilePath : job.prefetchedMap->parallaxTextureFilePaths) {
+    TextureManager::the().prefetch(textureFilePath, TextureManager::Category::PARALLAX);
+  }
+}
+
+}  // namespace requiem
@@ -0,0 +1,76 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_MAP_MAP_PREFETCHER_H_
+#define REQUIEM_MAP_MAP_PREFETCHER_H_
+
+#include <future>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <axmol.h>
+
+#include "map/NavTiledMap.h"
+
+namespace requiem {
+
+// Prepares the game maps which the player is likely to go to next, i.e., the
+// destinations of the portals in the current game map, in the background.
+//
+// A worker thread reads and parses the .tmx file and builds its nav tiles.
+// Once it has finished, the tileset and parallax background textures are
+// decoded on ax::TextureCache's loader thread. Entering a portal to a
+// prefetched game map then only has to build the nodes from the parsed
+// map info, without parsing the .tmx file again.
+class MapPrefetcher final {
+ public:
+  struct PrefetchedMap final {
+    // Created by hand rather than autoreleased, see prepare().
+    ax::RefPtr<ax::TMXMapInfo> mapInfo;
+    NavTiledMap::NavTiles navTiles;
+    std::vector<std::string> tilesetTextureFilePaths;
+    std::vector<std::string> parallaxTextureFilePaths;
+  };
+
+  MapPrefetcher() = default;
+  MapPrefetcher(const MapPrefetcher&) = delete;
+  MapPrefetcher& operator=(const MapPrefetcher&) = delete;
+
+  // Collects the game maps which have been prepared, and prefetches their textures.
+  void update();
+
+  // Starts prefetching the given game maps (at most kMaxNumPrefetchedMaps of them),
+  // and drops the previously prefetched ones which are not among them.
+  void prefetch(const std::vector<std::string>& tmxMapFilePaths);
+
+  // @return: the prefetched game map, or std::nullopt if it hasn't been prefetched.
+  //          If it is still being prepared, this waits for it to finish.
+  std::optional<PrefetchedMap> take(const std::string& tmxMapFilePath);
+
+  std::vector<std::string> getReport() const;
+
+  static inline constexpr int kMaxNumPrefetchedMaps = 4;
+
+ private:
+  struct Job final {
+    std::future<std::optional<PrefetchedMap>> future;
+    std::optional<PrefetchedMap> prefetchedMap;
+    bool isDone{};
+    bool isWanted{true};
+  };
+
+  // Runs on a worker thread, so it mustn't create any nodes or touch the scene graph.
+  static std::optional<PrefetchedMap> prepare(const std::string& fullPath,
+                                              const std::string& resourcePath);
+
+  void onPrepared(Job& job);
+
+  std::unordered_map<std::string, Job> _jobs;
+  size_t _numHits{};
+  size_t _numMisses{};
+};
+
+}  // namespace requiem
+
+#endif  // REQUIEM_MAP_MAP_PREFETCHER_H_
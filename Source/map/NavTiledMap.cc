@@ -7,15 +7,40 @@ USING_NS_AX;
 
 namespace requiem {
 
+namespace {
+
+NavTiledMap::TileType getTileType(const uint32_t gid, const uint32_t firstGid) {
+  if (!gid) {
+    return NavTiledMap::TileType::EMPTY;
+  }
+
+  return static_cast<NavTiledMap::TileType>(gid - firstGid);
+}
+
+}  // namespace
+
 NavTiledMap::NavTiledMap(const TMXTiledMap& tmxTiledMap)
     : _tmxTiledMap{tmxTiledMap},
       _bitmapLayer{tmxTiledMap.getLayer("Bitmap")},
-      _navTiles{buildNavTiles()} {}
+      _mapSize{tmxTiledMap.getMapSize()},
+      _tileSize{tmxTiledMap.getTileSize()} {
+  if (_bitmapLayer) {
+    _navTiles = buildNavTiles(_mapSize, _bitmapLayer->getTiles(),
+                              _bitmapLayer->getTileSet()->_firstGid);
+  }
+}
+
+NavTiledMap::NavTiledMap(const TMXTiledMap& tmxTiledMap, NavTiles&& navTiles)
+    : _tmxTiledMap{tmxTiledMap},
+      _bitmapLayer{tmxTiledMap.getLayer("Bitmap")},
+      _mapSize{tmxTiledMap.getMapSize()},
+      _tileSize{tmxTiledMap.getTileSize()},
+      _navTiles{std::move(navTiles)} {}
 
 ax::Vec2 NavTiledMap::getTileCoordinate(const ax::Vec2& pos) const {
-  const float tileWidth = _tmxTiledMap.getTileSize().width;
-  const float tileHeight = _tmxTiledMap.getTileSize().height;
-  const int mapHeight = _tmxTiledMap.getMapSize().height;
+  const float tileWidth = _tileSize.width;
+  const float tileHeight = _tileSize.height;
+  const int mapHeight = _mapSize.height;
 
   const int tileX = static_cast<int>(pos.x / tileWidth);
   const int tileY = mapHeight - 1 - static_cast<int>(pos.y / tileHeight);
@@ -23,9 +48,9 @@ ax::Vec2 NavTiledMap::getTileCoordinate(const ax::Vec2& pos) const {
 }
 
 ax::Vec2 NavTiledMap::getTilePos(const ax::Vec2& tileCoordinate) const {
-  const float tileWidth = _tmxTiledMap.getTileSize().width;
-  const float tileHeight = _tmxTiledMap.getTileSize().height;
-  const int mapHeight = _tmxTiledMap.getMapSize().height;
+  const float tileWidth = _tileSize.width;
+  const float tileHeight = _tileSize.height;
+  const int mapHeight = _mapSize.height;
 
   const int posX = (tileCoordinate.x + 0.5f) * tileWidth;
   const int posY = (mapHeight - 1 - tileCoordinate.y + 0.5f) * tileHeight;
@@ -36,20 +61,19 @@ const NavTiledMap::NavTile& NavTiledMap::getNavTile(const ax::Vec2 &tileCoordina
   return _navTiles[tileCoordinate.x][tileCoordinate.y];
 }
 
-vector<vector<NavTiledMap::NavTile>> NavTiledMap::buildNavTiles() const {
-  if (!_bitmapLayer) {
-    return {};
-  }
-
+NavTiledMap::NavTiles NavTiledMap::buildNavTiles(const Size& mapSize,
+                                                  const uint32_t* gids,
+                                                  const uint32_t firstGid) {
   // Make navTiles column-major so that the way we access its individual cell
   // would appear more natural.
-  const int numCols = _tmxTiledMap.getMapSize().x;
-  const int numRows = _tmxTiledMap.getMapSize().y;
-  vector<vector<NavTile>> navTiles(numCols, vector<NavTile>(numRows));
+  const int numCols = mapSize.width;
+  const int numRows = mapSize.height;
+  NavTiles navTiles(numCols, vector<NavTile>(numRows));
 
+  // The gids are row-major, and the flip flags are stored in their highest bits.
   for (int x = 0; x < numCols; x++) {
     for (int y = 0; y < numRows; y++) {
-      navTiles[x][y].type = getTileType(Vec2(x, y));
+      navTiles[x][y].type = getTileType(gids[x + y * numCols] & kTMXFlippedMask, firstGid);
     }
   }
 
@@ -98,14 +122,4 @@ vector<vector<NavTiledMap::NavTile>> NavTiledMap::buildNavTiles() const {
   return navTiles;
 }
 
-NavTiledMap::TileType NavTiledMap::getTileType(const ax::Vec2& tileCoordinate) const {
-  const int gid = _bitmapLayer->getTileGIDAt(tileCoordinate);
-  if (!gid) {
-    return TileType::EMPTY;
-  }
-
-  const int baseGid = _bitmapLayer->getTileSet()->_firstGid;
-  return static_cast<TileType>(gid - baseGid);
-}
-
 }  // namespace requiem
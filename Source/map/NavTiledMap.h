@@ -3,6 +3,7 @@
 #ifndef REQUIEM_MAP_NAV_TILED_MAP_H_
 #define REQUIEM_MAP_NAV_TILED_MAP_H_
 
+#include <cstdint>
 #include <vector>
 
 #include <axmol.h>
@@ -25,7 +26,11 @@ class NavTiledMap final {
     bool canJumpDown{};
   };
 
+  using NavTiles = std::vector<std::vector<NavTile>>;
+
   explicit NavTiledMap(const ax::TMXTiledMap& tmxTiledMap);
+  // Reuses the nav tiles which have been built in advance, e.g., by MapPrefetcher.
+  NavTiledMap(const ax::TMXTiledMap& tmxTiledMap, NavTiles&& navTiles);
   NavTiledMap(const NavTiledMap&) = delete;
   NavTiledMap& operator=(const NavTiledMap&) = delete;
 
@@ -34,16 +39,22 @@ class NavTiledMap final {
   const NavTile& getNavTile(const ax::Vec2& tileCoordinate) const;
 
   inline const ax::TMXTiledMap& getTmxTiledMap() const { return _tmxTiledMap; }
+  inline const ax::Size& getMapSize() const { return _mapSize; }
   inline ax::FastTMXLayer* getBitmapLayer() const { return _bitmapLayer; }
 
- private:
-  std::vector<std::vector<NavTile>> buildNavTiles() const;
-  TileType getTileType(const ax::Vec2& tileCoordinate) const;
+  // Builds the nav tiles from the gids of the "Bitmap" layer. This doesn't
+  // touch any nodes, so it may be called off the main thread.
+  static NavTiles buildNavTiles(const ax::Size& mapSize, const uint32_t* gids, const uint32_t firstGid);
 
+ private:
   const ax::TMXTiledMap& _tmxTiledMap;
   ax::FastTMXLayer* _bitmapLayer{};
-  
-  std::vector<std::vector<NavTile>> _navTiles;
+
+  // Copied from `_tmxTiledMap`, so that the queries above don't touch
+  // any nodes and may be made from the AI worker threads.
+  ax::Size _mapSize;
+  ax::Size _tileSize;
+  NavTiles _navTiles;
 };
 
 }  // namespace requiem
@@ -2,6 +2,7 @@
 
 #include "ParallaxBackground.h"
 
+#include "TextureManager.h"
 #include "scene/SceneManager.h"
 
 namespace fs = std::filesystem;
@@ -20,6 +21,8 @@ void InfiniteParallaxNode::addLayer(const string& filePath,
                                     const Vec2& parallaxRatio,
                                     const Vec2& position,
                                     const Vec2& scale) {
+  TextureManager::the().acquire(filePath, TextureManager::Category::PARALLAX);
+
   auto spriteA = Sprite::create(filePath);
   spriteA->setLocalZOrder(z);
   spriteA->setPosition(position);
@@ -98,23 +101,31 @@ bool ParallaxBackground::load(const fs::path& bgDirPath, const float bgScale) {
     return false;
   }
 
-  constexpr int kMax = 10;
-  for (int i = 0; i < kMax; i++) {
-    const string bgFileName = std::to_string(i) + ".png";
-    const fs::path bgPath = bgDirPath / bgFileName;
-    if (!fs::exists(bgPath, ec)) {
-      break;
-    }
-
+  const vector<fs::path> bgPaths = getLayerFilePaths(bgDirPath);
+  for (int i = 0; i < static_cast<int>(bgPaths.size()); i++) {
     const auto& winSize = Director::getInstance()->getWinSize();
     const int z = i;
     const Vec2 parallaxRatio{(5.0f * i) / kPpm, 0};
     const Vec2 position{winSize.width / 2, winSize.height / 2};
     const Vec2 scale{bgScale, bgScale};
-    _parallaxNode->addLayer(bgPath, i, parallaxRatio, position, scale);
+    _parallaxNode->addLayer(bgPaths[i], i, parallaxRatio, position, scale);
   }
 
   return true;
 }
 
+vector<fs::path> ParallaxBackground::getLayerFilePaths(const fs::path& bgDirPath) {
+  vector<fs::path> bgPaths;
+  error_code ec;
+  for (int i = 0; i < kMaxNumLayers; i++) {
+    const string bgFileName = std::to_string(i) + ".png";
+    fs::path bgPath = bgDirPath / bgFileName;
+    if (!fs::exists(bgPath, ec)) {
+      break;
+    }
+    bgPaths.push_back(std::move(bgPath));
+  }
+  return bgPaths;
+}
+
 }  // namespace requiem
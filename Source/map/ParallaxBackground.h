@@ -6,6 +6,7 @@
 #include <filesystem>
 #include <map>
 #include <string>
+#include <vector>
 
 #include <axmol.h>
 
@@ -55,6 +56,11 @@ class ParallaxBackground final {
 
   inline InfiniteParallaxNode* getParallaxNode() const { return _parallaxNode; }
 
+  // @return: the images of the layers in `bgDirPath`, from the farthest to the nearest.
+  static std::vector<std::filesystem::path> getLayerFilePaths(const std::filesystem::path& bgDirPath);
+
+  static inline constexpr int kMaxNumLayers = 10;
+
  private:
   InfiniteParallaxNode* _parallaxNode{};
 };
@@ -3,7 +3,6 @@
 #include "PathFinder.h"
 
 #include <limits>
-#include <memory>
 #include <queue>
 #include <unordered_set>
 #include <vector>
@@ -17,11 +16,11 @@ USING_NS_AX;
 
 namespace requiem {
 
-optional<b2Vec2> AStarPathFinder::getNextWaypoint(const b2Vec2& srcPos,
+optional<b2Vec2> AStarPathFinder::getNextWaypoint(const NavTiledMap& navTiledMap,
+                                                  const b2Vec2& srcPos,
                                                   const b2Vec2& dstPos,
                                                   const float followDist) {
-  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
-  _navTiledMap = &gmMgr->getGameMap()->getNavTiledMap();
+  _navTiledMap = &navTiledMap;
 
   const Vec2 src = _navTiledMap->getTileCoordinate(Vec2{srcPos.x * kPpm, srcPos.y * kPpm});
   const Vec2 dst = _navTiledMap->getTileCoordinate(Vec2{dstPos.x * kPpm, dstPos.y * kPpm});
@@ -38,21 +37,18 @@ optional<b2Vec2> AStarPathFinder::getNextWaypoint(const b2Vec2& srcPos,
   return ret;
 }
 
-void AStarPathFinder::reset() {
-  _nodes.clear();
-}
-
 list<b2Vec2> AStarPathFinder::findPath(const Vec2& srcTileCoordinate,
                                        const Vec2& dstTileCoordinate) {
-  reset();
-
+  // Everything below is allocated from the frame arena, since the path
+  // is copied out before this returns.
+  Nodes nodes;
   auto minHeapCmp = [](const Node* n1, const Node* n2) { return n1->f > n2->f; };
-  using MinHeap = priority_queue<Node*, vector<Node*>, decltype(minHeapCmp)>;
+  using MinHeap = priority_queue<Node*, FrameVector<Node*>, decltype(minHeapCmp)>;
   MinHeap frontier{minHeapCmp};
-  unordered_set<Node*> openSet;
-  unordered_set<Vec2> closedSet;
+  FrameUnorderedSet<Node*> openSet;
+  FrameUnorderedSet<Vec2> closedSet;
 
-  Node* root = getOrCreateNode(srcTileCoordinate);
+  Node* root = getOrCreateNode(srcTileCoordinate, nodes);
   assert(root);
   frontier.push(root);
   openSet.insert(root);
@@ -68,7 +64,7 @@ list<b2Vec2> AStarPathFinder::findPath(const Vec2& srcTileCoordinate,
 
     closedSet.insert(current->navTileCoordinate);
 
-    for (auto neighbor : getNeighbors(current)) {
+    for (auto neighbor : getNeighbors(current, nodes)) {
       if (closedSet.contains(neighbor->navTileCoordinate)) {
         continue;
       }
@@ -88,7 +84,6 @@ list<b2Vec2> AStarPathFinder::findPath(const Vec2& srcTileCoordinate,
     }
   }
 
-  reset();
   return {};
 }
 
@@ -103,13 +98,14 @@ list<b2Vec2> AStarPathFinder::reconstructPath(const Node* dstNode) const {
   return path;
 }
 
-list<AStarPathFinder::Node*>AStarPathFinder::getNeighbors(const Node* node) {
+FrameVector<AStarPathFinder::Node*> AStarPathFinder::getNeighbors(const Node* node, Nodes& nodes) {
   if (!node) {
     return {};
   }
 
-  list<Node*> neighbors;
-  const Vec2& mapSize = _navTiledMap->getTmxTiledMap().getMapSize();
+  FrameVector<Node*> neighbors;
+  neighbors.reserve(6);
+  const Size& mapSize = _navTiledMap->getMapSize();
   const Vec2& currentPos = node->navTileCoordinate;
   const NavTiledMap::NavTile& currentTile = _navTiledMap->getNavTile(currentPos);
 
@@ -117,41 +113,41 @@ list<AStarPathFinder::Node*>AStarPathFinder::getNeighbors(const Node* node) {
   if (currentPos.x > 0) {
      const NavTiledMap::NavTile& leftTile = _navTiledMap->getNavTile({currentPos.x - 1, currentPos.y});
      if (!leftTile.hasTrapBelow) {
-       neighbors.push_back(getOrCreateNode({currentPos.x - 1, currentPos.y}));
+       neighbors.push_back(getOrCreateNode({currentPos.x - 1, currentPos.y}, nodes));
      }
   }
 
   // move right
-  if (currentPos.x < mapSize.x - 1) {
+  if (currentPos.x < mapSize.width - 1) {
     const NavTiledMap::NavTile& rightTile = _navTiledMap->getNavTile({currentPos.x + 1, currentPos.y});
     if (!rightTile.hasTrapBelow) {
-      neighbors.push_back(getOrCreateNode({currentPos.x + 1, currentPos.y}));
+      neighbors.push_back(getOrCreateNode({currentPos.x + 1, currentPos.y}, nodes));
     }
   }
 
   // jump straight up
   if (currentPos.y > 0) {
     const NavTiledMap::NavTile& aboveTile = _navTiledMap->getNavTile({currentPos.x, currentPos.y - 1});
-    neighbors.push_back(getOrCreateNode({currentPos.x, currentPos.y - 1}));
+    neighbors.push_back(getOrCreateNode({currentPos.x, currentPos.y - 1}, nodes));
 
     // jump leftward
     if (currentPos.x > 0) {
       const NavTiledMap::NavTile& jumpRightwardTile = _navTiledMap->getNavTile({currentPos.x - 1, currentPos.y - 1});
-      neighbors.push_back(getOrCreateNode({currentPos.x - 1, currentPos.y - 1}));
+      neighbors.push_back(getOrCreateNode({currentPos.x - 1, currentPos.y - 1}, nodes));
     }
 
     // jump rightward
-    if (currentPos.x < mapSize.x - 1) {
+    if (currentPos.x < mapSize.width - 1) {
       const NavTiledMap::NavTile& jumpRightwardTile = _navTiledMap->getNavTile({currentPos.x + 1, currentPos.y - 1});
-      neighbors.push_back(getOrCreateNode({currentPos.x + 1, currentPos.y - 1}));
+      neighbors.push_back(getOrCreateNode({currentPos.x + 1, currentPos.y - 1}, nodes));
     }
   }
 
   // move down
-  if (currentPos.y < mapSize.y - 1) {
+  if (currentPos.y < mapSize.height - 1) {
      const NavTiledMap::NavTile& belowTile = _navTiledMap->getNavTile({currentPos.x, currentPos.y + 1});
      if (currentTile.canJumpDown && belowTile.hasSurfaceBelow) {
-       neighbors.push_back(getOrCreateNode({currentPos.x, currentPos.y + 1}));
+       neighbors.push_back(getOrCreateNode({currentPos.x, currentPos.y + 1}, nodes));
      }
   }
 
@@ -168,19 +164,16 @@ int AStarPathFinder::heuristic(const ax::Vec2& tileCoordinate, const ax::Vec2& d
   return dx + dy * 3.f;  // punish vertical movement
 }
 
-AStarPathFinder::Node* AStarPathFinder::getOrCreateNode(const Vec2 &tileCoordinate) {
-  auto it = _nodes.find(tileCoordinate);
-  if (it != _nodes.end()) {
-    return it->second.get();
+AStarPathFinder::Node* AStarPathFinder::getOrCreateNode(const Vec2 &tileCoordinate, Nodes& nodes) {
+  auto it = nodes.find(tileCoordinate);
+  if (it == nodes.end()) {
+    it = nodes.emplace(tileCoordinate, Node{tileCoordinate, nullptr, 0, 0, 0}).first;
   }
-
-  auto newNode = make_unique<Node>(tileCoordinate, nullptr, 0, 0, 0);
-  auto newNodeRawPtr = newNode.get();
-  _nodes[tileCoordinate] = std::move(newNode);
-  return newNodeRawPtr;
+  return &it->second;
 }
 
-optional<b2Vec2> SimplePathFinder::getNextWaypoint(const b2Vec2& srcPos,
+optional<b2Vec2> SimplePathFinder::getNextWaypoint(const NavTiledMap& navTiledMap,
+                                                   const b2Vec2& srcPos,
                                                    const b2Vec2& destPos,
                                                    const float followDist) {
   if (destPos.y - srcPos.y < followDist) {
@@ -4,14 +4,13 @@
 #define REQUIEM_MAP_PATH_FINDER_H_
 
 #include <list>
-#include <memory>
 #include <optional>
-#include <unordered_map>
 
 #include <box2d/box2d.h>
 
 #include "map/NavTiledMap.h"
 #include "util/AxUtil.h"
+#include "util/FrameArena.h"
 
 namespace requiem {
 
@@ -22,11 +21,14 @@ class PathFinder {
   PathFinder& operator=(const PathFinder&) = delete;
   virtual ~PathFinder() = default;
 
-  virtual std::optional<b2Vec2> getNextWaypoint(const b2Vec2& srcPos,
+  virtual std::optional<b2Vec2> getNextWaypoint(const NavTiledMap& navTiledMap,
+                                                const b2Vec2& srcPos,
                                                 const b2Vec2& destPos,
                                                 const float followDist) = 0;
 };
 
+// The path queries may be made from the AI worker threads, so this must only read
+// the given NavTiledMap, which never changes once the game map has been loaded.
 class AStarPathFinder final : public PathFinder {
  public:
   struct Node {
@@ -37,29 +39,32 @@ class AStarPathFinder final : public PathFinder {
     int f{};  // f = g + h
   };
 
-  virtual std::optional<b2Vec2> getNextWaypoint(const b2Vec2& srcPos,
+  virtual std::optional<b2Vec2> getNextWaypoint(const NavTiledMap& navTiledMap,
+                                                const b2Vec2& srcPos,
                                                 const b2Vec2& dstPos,
                                                 const float followDist) override;
-  void reset();
-  
+
  private:
+  // The nodes visited by a single search, which are discarded along with the frame.
+  using Nodes = FrameUnorderedMap<ax::Vec2, Node>;
+
   std::list<b2Vec2> findPath(const ax::Vec2& srcTileCoordinate,
                              const ax::Vec2& dstTileCoordinate);
   std::list<b2Vec2> reconstructPath(const Node* dstNode) const;
-  std::list<Node*> getNeighbors(const Node* node);
+  FrameVector<Node*> getNeighbors(const Node* node, Nodes& nodes);
   int getCostBetween(const Node* n1, const Node* n2) const;
   int heuristic(const ax::Vec2& tileCoordinate, const ax::Vec2& dstTileCoordinate) const;
-  Node* getOrCreateNode(const ax::Vec2& tileCoordinate);
+  Node* getOrCreateNode(const ax::Vec2& tileCoordinate, Nodes& nodes);
 
   const NavTiledMap* _navTiledMap{};
   ax::Vec2 _destPos;
   std::list<b2Vec2> _path;
-  std::unordered_map<ax::Vec2, std::unique_ptr<Node>> _nodes;
 };
 
 class SimplePathFinder final : public PathFinder {
  public:
-  virtual std::optional<b2Vec2> getNextWaypoint(const b2Vec2& srcPos,
+  virtual std::optional<b2Vec2> getNextWaypoint(const NavTiledMap& navTiledMap,
+                                                const b2Vec2& srcPos,
                                                 const b2Vec2& destPos,
                                                 const float followDist) override;
 };
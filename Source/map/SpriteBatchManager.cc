@@ -0,0 +1,79 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#include "SpriteBatchManager.h"
+
+#include <algorithm>
+
+#include "util/AxUtil.h"
+#include "util/Logger.h"
+#include "util/StringUtil.h"
+
+namespace fs = std::filesystem;
+using namespace std;
+USING_NS_AX;
+
+namespace requiem {
+
+void SpriteBatchManager::update() {
+  // The renderer's counter holds the number of draw calls issued in the previous frame.
+  _numDrawCalls = Director::getInstance()->getRenderer()->getDrawnBatches();
+  _peakNumDrawCalls = std::max(_peakNumDrawCalls, _numDrawCalls);
+}
+
+SpriteBatchNode* SpriteBatchManager::addSprite(Sprite* sprite,
+                                               const fs::path& textureFilePath,
+                                               const int zOrder) {
+  Texture2D* texture = Director::getInstance()->getTextureCache()->addImage(textureFilePath.native());
+  if (!texture) {
+    VGLOG(LOG_ERR, "Failed to create sprite batch node for [%s].", textureFilePath.c_str());
+    return nullptr;
+  }
+  return addSprite(sprite, texture, zOrder);
+}
+
+SpriteBatchNode* SpriteBatchManager::addSprite(Sprite* sprite,
+                                               Texture2D* texture,
+                                               const int zOrder) {
+  const BatchKey key{texture, zOrder};
+
+  auto it = _spriteBatchNodes.find(key);
+  if (it == _spriteBatchNodes.end()) {
+    SpriteBatchNode* spriteBatchNode = SpriteBatchNode::createWithTexture(texture);
+    if (!spriteBatchNode) {
+      VGLOG(LOG_ERR, "Failed to create sprite batch node for [%s].", texture->getPath().c_str());
+      return nullptr;
+    }
+    spriteBatchNode->getTexture()->setAliasTexParameters();  // disable texture antialiasing
+    ax_util::addChildWithParentCameraMask(_layer, spriteBatchNode, zOrder);
+    it = _spriteBatchNodes.emplace(key, spriteBatchNode).first;
+  }
+
+  ax_util::addChildWithParentCameraMask(it->second, sprite);
+  return it->second;
+}
+
+void SpriteBatchManager::removeEmptySpriteBatchNodes() {
+  for (auto it = _spriteBatchNodes.begin(); it != _spriteBatchNodes.end();) {
+    if (it->second->getChildrenCount() > 0) {
+      it++;
+      continue;
+    }
+    _layer->removeChild(it->second);
+    it = _spriteBatchNodes.erase(it);
+  }
+}
+
+vector<string> SpriteBatchManager::getReport() const {
+  int numSprites = 0;
+  for (const auto& [_, spriteBatchNode] : _spriteBatchNodes) {
+    numSprites += static_cast<int>(spriteBatchNode->getChildrenCount());
+  }
+
+  return {
+    string_util::format("draw calls: %u (peak: %u)", _numDrawCalls, _peakNumDrawCalls),
+    string_util::format("sprite batches: %d, batched sprites: %d",
+                        static_cast<int>(_spriteBatchNodes.size()), numSprites),
+  };
+}
+
+}  // namespace requiem
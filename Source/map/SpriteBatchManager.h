@@ -0,0 +1,52 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_MAP_SPRITE_BATCH_MANAGER_H_
+#define REQUIEM_MAP_SPRITE_BATCH_MANAGER_H_
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <axmol.h>
+
+namespace requiem {
+
+// Owns one ax::SpriteBatchNode per (texture, z order) in GameMapManager's layer,
+// so that the actors and fx sharing a spritesheet are drawn in a single draw call.
+class SpriteBatchManager final {
+ public:
+  explicit SpriteBatchManager(ax::Layer* layer) : _layer{layer} {}
+  SpriteBatchManager(const SpriteBatchManager&) = delete;
+  SpriteBatchManager& operator=(const SpriteBatchManager&) = delete;
+
+  void update();
+
+  // Adds the sprite to the batch of the given texture and z order,
+  // creating the batch if necessary.
+  // @return: the batch which the sprite has been added to.
+  ax::SpriteBatchNode* addSprite(ax::Sprite* sprite,
+                                 const std::filesystem::path& textureFilePath,
+                                 const int zOrder);
+  ax::SpriteBatchNode* addSprite(ax::Sprite* sprite,
+                                 ax::Texture2D* texture,
+                                 const int zOrder);
+  void removeEmptySpriteBatchNodes();
+
+  std::vector<std::string> getReport() const;
+
+ private:
+  // Keyed by the texture itself rather than its path, since the same
+  // texture may be referred to by both relative and full paths.
+  using BatchKey = std::pair<const ax::Texture2D*, int>;
+
+  ax::Layer* _layer;
+  std::map<BatchKey, ax::SpriteBatchNode*> _spriteBatchNodes;
+  unsigned int _numDrawCalls{};
+  unsigned int _peakNumDrawCalls{};
+};
+
+}  // namespace requiem
+
+#endif  // REQUIEM_MAP_SPRITE_BATCH_MANAGER_H_
@@ -0,0 +1,115 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#include "VolumeManager.h"
+
+#include <algorithm>
+
+#include "character/Character.h"
+#include "scene/GameScene.h"
+#include "scene/SceneManager.h"
+#include "util/Logger.h"
+#include "util/StringUtil.h"
+
+using namespace std;
+
+namespace requiem {
+
+void VolumeManager::update(const float delta) {
+  for (auto& occupancy : _occupancies) {
+    onStay(occupancy, delta);
+  }
+}
+
+void VolumeManager::addVolume(Interactable* interactable, const Type type, const int damage) {
+  auto& volumes = _volumes[static_cast<size_t>(type)];
+  if (!_volumeIndices.emplace(interactable, make_pair(type, volumes.size())).second) {
+    VGLOG(LOG_ERR, "The volume has already been added.");
+    return;
+  }
+  volumes.push_back({interactable, damage, 0});
+}
+
+void VolumeManager::clear() {
+  for (auto& volumes : _volumes) {
+    volumes.clear();
+  }
+  _volumeIndices.clear();
+  _occupancies.clear();
+}
+
+void VolumeManager::onEnter(Interactable* interactable, Character* character) {
+  auto it = _volumeIndices.find(interactable);
+  if (it == _volumeIndices.end()) {
+    return;
+  }
+
+  const auto [type, volumeIdx] = it->second;
+  _volumes[static_cast<size_t>(type)][volumeIdx].numOccupants++;
+  _occupancies.push_back({type, volumeIdx, character, 0});
+
+  // A hazard hurts as soon as it is entered, and then once per tick.
+  if (type == Type::HAZARD) {
+    _occupancies.back().hazardTimer = kHazardTickIntervalSec;
+    onStay(_occupancies.back(), 0);
+  }
+}
+
+void VolumeManager::onExit(Interactable* interactable, Character* character) {
+  auto it = _volumeIndices.find(interactable);
+  if (it == _volumeIndices.end()) {
+    return;
+  }
+
+  const auto [type, volumeIdx] = it->second;
+  auto occupancyIt = std::find_if(_occupancies.begin(), _occupancies.end(),
+                                  [type = type, volumeIdx = volumeIdx, character](const Occupancy& o) {
+    return o.type == type && o.volumeIdx == volumeIdx && o.character == character;
+  });
+  if (occupancyIt == _occupancies.end()) {
+    return;
+  }
+
+  _volumes[static_cast<size_t>(type)][volumeIdx].numOccupants--;
+  *occupancyIt = _occupancies.back();
+  _occupancies.pop_back();
+}
+
+vector<string> VolumeManager::getReport() const {
+  auto numOccupiedVolumes = [this](const Type type) {
+    const auto& volumes = _volumes[static_cast<size_t>(type)];
+    return static_cast<int>(std::count_if(volumes.begin(), volumes.end(), [](const Volume& v) {
+      return v.numOccupants > 0;
+    }));
+  };
+
+  return {
+    string_util::format("triggers: %d (%d occupied)",
+                        static_cast<int>(_volumes[static_cast<size_t>(Type::TRIGGER)].size()),
+                        numOccupiedVolumes(Type::TRIGGER)),
+    string_util::format("portals: %d (%d occupied)",
+                        static_cast<int>(_volumes[static_cast<size_t>(Type::PORTAL)].size()),
+                        numOccupiedVolumes(Type::PORTAL)),
+    string_util::format("hazards: %d (%d occupied)",
+                        static_cast<int>(_volumes[static_cast<size_t>(Type::HAZARD)].size()),
+                        numOccupiedVolumes(Type::HAZARD)),
+    string_util::format("occupants: %d", static_cast<int>(_occupancies.size())),
+  };
+}
+
+void VolumeManager::onStay(Occupancy& occupancy, const float delta) {
+  if (occupancy.type != Type::HAZARD) {
+    return;
+  }
+
+  occupancy.hazardTimer += delta;
+  if (occupancy.hazardTimer < kHazardTickIntervalSec) {
+    return;
+  }
+  occupancy.hazardTimer = 0;
+
+  const Volume& volume = _volumes[static_cast<size_t>(Type::HAZARD)][occupancy.volumeIdx];
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  gmMgr->getDamageQueue()->push({nullptr, occupancy.character, volume.damage});
+}
+
+}  // namespace requiem
@@ -0,0 +1,72 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_MAP_VOLUME_MANAGER_H_
+#define REQUIEM_MAP_VOLUME_MANAGER_H_
+
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Interactable.h"
+
+namespace requiem {
+
+class Character;
+
+// Keeps track of the sensor volumes of the current game map (triggers,
+// portals and hazards) and the characters standing inside of them.
+// Enter/exit events come from WorldContactListener, and the stay events
+// are delivered once per frame to the occupied volumes only, so the cost
+// scales with the number of occupants rather than the number of characters.
+class VolumeManager final {
+ public:
+  enum class Type {
+    TRIGGER,
+    PORTAL,
+    HAZARD,  // a trigger which inflicts damage over time
+    SIZE
+  };
+
+  VolumeManager() = default;
+  VolumeManager(const VolumeManager&) = delete;
+  VolumeManager& operator=(const VolumeManager&) = delete;
+
+  void update(const float delta);
+
+  void addVolume(Interactable* interactable, const Type type, const int damage = 0);
+  void clear();
+
+  // These are no-ops if the interactable isn't a registered volume.
+  void onEnter(Interactable* interactable, Character* character);
+  void onExit(Interactable* interactable, Character* character);
+
+  std::vector<std::string> getReport() const;
+
+  static inline constexpr float kHazardTickIntervalSec = .1f;
+
+ private:
+  struct Volume final {
+    Interactable* interactable{};
+    int damage{};
+    int numOccupants{};
+  };
+
+  struct Occupancy final {
+    Type type{};
+    size_t volumeIdx{};
+    Character* character{};
+    float hazardTimer{};
+  };
+
+  void onStay(Occupancy& occupancy, const float delta);
+
+  std::array<std::vector<Volume>, static_cast<size_t>(Type::SIZE)> _volumes;
+  std::unordered_map<const Interactable*, std::pair<Type, size_t>> _volumeIndices;
+  std::vector<Occupancy> _occupancies;
+};
+
+}  // namespace requiem
+
+#endif  // REQUIEM_MAP_VOLUME_MANAGER_H_
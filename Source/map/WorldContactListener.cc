@@ -77,7 +77,9 @@ void WorldContactListener::BeginContact(b2Contact* contact) {
       if (playerFixture && enemyFixture) {
         Character* player = reinterpret_cast<Character*>(playerFixture->GetUserData().pointer);
         Character* enemy = reinterpret_cast<Character*>(enemyFixture->GetUserData().pointer);
-        player->onBodyContactWithEnemyBody(enemy);
+        if (enemy->isHostile(player)) {
+          player->onBodyContactWithEnemyBody(enemy);
+        }
       }
       break;
     }
@@ -89,7 +91,9 @@ void WorldContactListener::BeginContact(b2Contact* contact) {
       if (npcFixture && enemyFixture) {
         Character* npc = reinterpret_cast<Character*>(npcFixture->GetUserData().pointer);
         Character* enemy = reinterpret_cast<Character*>(enemyFixture->GetUserData().pointer);
-        npc->onBodyContactWithEnemyBody(enemy);
+        if (enemy->isHostile(npc)) {
+          npc->onBodyContactWithEnemyBody(enemy);
+        }
       }
       break;
     }
@@ -124,6 +128,9 @@ void WorldContactListener::BeginContact(b2Contact* contact) {
       if (weaponFixture && enemyFixture) {
         Character* attacker = reinterpret_cast<Character*>(weaponFixture->GetUserData().pointer);
         Character* enemy = reinterpret_cast<Character*>(enemyFixture->GetUserData().pointer);
+        if (!attacker->isHostile(enemy)) {
+          break;
+        }
         attacker->getInRangeTargets().insert(enemy);
         attacker->onMeleeWeaponContactWithEnemyBody(enemy);
       }
@@ -137,6 +144,9 @@ void WorldContactListener::BeginContact(b2Contact* contact) {
       if (weaponFixture && playerFixture) {
         Character* attacker = reinterpret_cast<Character*>(weaponFixture->GetUserData().pointer);
         Character* player = reinterpret_cast<Character*>(playerFixture->GetUserData().pointer);
+        if (!attacker->isHostile(player)) {
+          break;
+        }
         attacker->getInRangeTargets().insert(player);
         attacker->onMeleeWeaponContactWithEnemyBody(player);
       }
@@ -150,6 +160,9 @@ void WorldContactListener::BeginContact(b2Contact* contact) {
       if (weaponFixture && npcFixture) {
         Character* attacker = reinterpret_cast<Character*>(weaponFixture->GetUserData().pointer);
         Character* npc = reinterpret_cast<Character*>(npcFixture->GetUserData().pointer);
+        if (!attacker->isHostile(npc)) {
+          break;
+        }
         attacker->getInRangeTargets().insert(npc);
         attacker->onMeleeWeaponContactWithEnemyBody(npc);
       }
@@ -177,6 +190,9 @@ void WorldContactListener::BeginContact(b2Contact* contact) {
         GameMap::Portal* p = reinterpret_cast<GameMap::Portal*>(portalFixture->GetUserData().pointer);
         c->setPortal(p);
 
+        auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+        gmMgr->getVolumeManager()->onEnter(p, c);
+
         if (p->willInteractOnContact()) {
           CallbackManager::the().runAfter([c, p](const CallbackManager::CallbackId) {
             c->interact(p);
@@ -196,6 +212,9 @@ void WorldContactListener::BeginContact(b2Contact* contact) {
         Character* c = reinterpret_cast<Character*>(feetFixture->GetUserData().pointer);
         Interactable* i = reinterpret_cast<Interactable*>(interactableFixture->GetUserData().pointer);
 
+        auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+        gmMgr->getVolumeManager()->onEnter(i, c);
+
         if (i->willInteractOnContact()) {
           CallbackManager::the().runAfter([c, i](const CallbackManager::CallbackId) {
             c->interact(i);
@@ -224,7 +243,7 @@ void WorldContactListener::BeginContact(b2Contact* contact) {
         Character* c = reinterpret_cast<Character*>(playerFixture->GetUserData().pointer);
 
         Projectile* missile = dynamic_cast<Projectile*>(p);
-        if (missile->getUser() == c) {
+        if (const Character* user = missile->getUser(); user == c || (user && !user->isHostile(c))) {
           contact->SetEnabled(false);
           return;
         }
@@ -242,7 +261,7 @@ void WorldContactListener::BeginContact(b2Contact* contact) {
         Character* c = reinterpret_cast<Character*>(enemyFixture->GetUserData().pointer);
 
         Projectile* missile = dynamic_cast<Projectile*>(p);
-        if (missile->getUser() == c) {
+        if (const Character* user = missile->getUser(); user == c || (user && !user->isHostile(c))) {
           contact->SetEnabled(false);
           return;
         }
@@ -338,6 +357,9 @@ void WorldContactListener::EndContact(b2Contact* contact) {
         GameMap::Portal* p = reinterpret_cast<GameMap::Portal*>(portalFixture->GetUserData().pointer);
         c->setPortal(nullptr);
         p->hideHintUI();
+
+        auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+        gmMgr->getVolumeManager()->onExit(p, c);
       }
       break;
     }
@@ -352,6 +374,9 @@ void WorldContactListener::EndContact(b2Contact* contact) {
         c->getInRangeInteractables().remove(i);
         i->hideHintUI();
 
+        auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+        gmMgr->getVolumeManager()->onExit(i, c);
+
         if (c->getInRangeInteractables().size()) {
           c->getInRangeInteractables().front()->showHintUI();
         }
@@ -0,0 +1,458 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#include "WorldStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Constants.h"
+#include "character/Npc.h"
+#include "character/Player.h"
+#include "item/Item.h"
+#include "map/GameMap.h"
+#include "map/object/Chest.h"
+#include "map/object/StaticObject.h"
+#include "scene/GameScene.h"
+#include "scene/SceneManager.h"
+#include "util/B2BodyBuilder.h"
+#include "util/Logger.h"
+#include "util/StringUtil.h"
+
+using namespace std;
+USING_NS_AX;
+
+namespace requiem {
+
+namespace {
+
+inline Rect inflate(const Rect& rect, const float margin) {
+  return {rect.origin.x - margin, rect.origin.y - margin,
+          rect.size.width + margin * 2, rect.size.height + margin * 2};
+}
+
+// Whether the npc can be turned into a snapshot without interrupting anything,
+// i.e., none of its pending callbacks or anyone else would still refer to it.
+bool isAtRest(const Npc* npc) {
+  return !npc->hasPendingCallbacks() &&
+         !npc->getParty() &&
+         !npc->isSetToKill() &&
+         !npc->isAttacking() &&
+         !npc->isUsingSkill() &&
+         !npc->isDodging() &&
+         !npc->isJumping() &&
+         !npc->isStunned() &&
+         !npc->getLockedOnTarget();
+}
+
+}  // namespace
+
+WorldStreamer::WorldStreamer(b2World* world, GameMap& gameMap, const Size& mapSize)
+    : _world{world},
+      _gameMap{gameMap},
+      _numCols{std::max(1, static_cast<int>(std::ceil(mapSize.width / kChunkSize)))},
+      _numRows{std::max(1, static_cast<int>(std::ceil(mapSize.height / kChunkSize)))},
+      _chunks(_numCols * _numRows) {}
+
+WorldStreamer::~WorldStreamer() {
+  // The actors are removed by GameMap, so only the bodies are left.
+  for (auto& staticBody : _staticBodies) {
+    if (staticBody.body) {
+      _world->DestroyBody(staticBody.body);
+    }
+  }
+}
+
+void WorldStreamer::update(const Vec2& focus, const bool shouldLoadAllInRange) {
+  const Size& winSize = Director::getInstance()->getWinSize();
+  const Rect visibleRect{focus.x - winSize.width / 2, focus.y - winSize.height / 2,
+                         winSize.width, winSize.height};
+  const Rect loadRect = inflate(visibleRect, kLoadMargin);
+  const Rect unloadRect = inflate(visibleRect, kUnloadMargin);
+
+  vector<Chunk*> chunksToUnload;
+  for (int row = 0; row < _numRows; row++) {
+    for (int col = 0; col < _numCols; col++) {
+      Chunk& chunk = _chunks[row * _numCols + col];
+      if (chunk.isPinned) {
+        if (!chunk.isLoaded) {
+          loadChunk(chunk);
+        }
+      } else if (chunk.isLoaded && !getChunkRect(col, row).intersectsRect(unloadRect)) {
+        chunksToUnload.push_back(&chunk);
+      }
+    }
+  }
+
+  // A chunk is kept loaded while any npc in it is in the middle of something.
+  if (!chunksToUnload.empty()) {
+    for (const auto& actor : _gameMap.getDynamicActors()) {
+      if (isStreamed(actor.get()) && !canSweep(actor.get())) {
+        std::erase(chunksToUnload, &getChunk(actor->getBodySprite()->getPosition()));
+      }
+    }
+  }
+  for (auto chunk : chunksToUnload) {
+    unloadChunk(*chunk);
+  }
+
+  // The chunks on screen are loaded right away, and the others are spread across frames.
+  const auto [minCol, minRow] = getChunkCoordinate(loadRect.origin);
+  const auto [maxCol, maxRow] = getChunkCoordinate({loadRect.getMaxX(), loadRect.getMaxY()});
+  int numPrefetchedChunks = 0;
+  for (int row = minRow; row <= maxRow; row++) {
+    for (int col = minCol; col <= maxCol; col++) {
+      Chunk& chunk = _chunks[row * _numCols + col];
+      if (chunk.isLoaded) {
+        continue;
+      }
+
+      const bool isVisible = getChunkRect(col, row).intersectsRect(visibleRect);
+      if (!isVisible && !shouldLoadAllInRange && numPrefetchedChunks >= kMaxNumChunksLoadedPerFrame) {
+        continue;
+      }
+      loadChunk(chunk);
+      if (!isVisible) {
+        numPrefetchedChunks++;
+      }
+    }
+  }
+
+  // The npcs may also wander off into an unloaded chunk on their own, where there's
+  // no ground beneath them anymore, so check on them every frame.
+  sweepDynamicActors();
+}
+
+void WorldStreamer::addStaticBody(StaticBodyDesc&& desc) {
+  const size_t staticBodyIdx = _staticBodies.size();
+  const auto [minCol, minRow] = getChunkCoordinate(desc.bounds.origin);
+  const auto [maxCol, maxRow] = getChunkCoordinate({desc.bounds.getMaxX(), desc.bounds.getMaxY()});
+  _staticBodies.push_back({std::move(desc), nullptr, 0});
+
+  for (int row = minRow; row <= maxRow; row++) {
+    for (int col = minCol; col <= maxCol; col++) {
+      Chunk& chunk = _chunks[row * _numCols + col];
+      chunk.staticBodyIdxs.push_back(staticBodyIdx);
+      if (chunk.isLoaded) {
+        retainStaticBody(_staticBodies.back());
+      }
+    }
+  }
+}
+
+void WorldStreamer::addStaticObject(StaticObjectDesc&& desc) {
+  getChunk(desc.pos).staticObjects.push_back(std::move(desc));
+}
+
+void WorldStreamer::addChest(ChestDesc&& desc) {
+  getChunk(desc.pos).chests.push_back(std::move(desc));
+}
+
+void WorldStreamer::addNpc(NpcSnapshot&& snapshot) {
+  snapshot.instanceId = Npc::allocateInstanceId();
+  getChunk(snapshot.pos).npcs.push_back(std::move(snapshot));
+}
+
+void WorldStreamer::restoreNpc(NpcSnapshot&& snapshot) {
+  for (auto& chunk : _chunks) {
+    std::erase_if(chunk.npcs, [&snapshot](const NpcSnapshot& parkedSnapshot) {
+      return parkedSnapshot.instanceId == snapshot.instanceId;
+    });
+  }
+
+  Chunk& chunk = getChunk(snapshot.pos);
+  if (chunk.isLoaded) {
+    spawnNpc(snapshot);
+  } else {
+    chunk.npcs.push_back(std::move(snapshot));
+  }
+}
+
+vector<WorldStreamer::NpcSnapshot> WorldStreamer::getNpcSnapshots() const {
+  vector<NpcSnapshot> snapshots;
+  for (const auto& chunk : _chunks) {
+    snapshots.insert(snapshots.end(), chunk.npcs.begin(), chunk.npcs.end());
+  }
+  return snapshots;
+}
+
+WorldStreamer::NpcSnapshot WorldStreamer::makeNpcSnapshot(Npc& npc) {
+  const Character::Profile& profile = npc.getCharacterProfile();
+  const b2Vec2& pos = npc.getBody()->GetPosition();
+
+  NpcSnapshot snapshot;
+  snapshot.instanceId = npc.getInstanceId();
+  snapshot.pos = {pos.x * kPpm, pos.y * kPpm};
+  snapshot.jsonFilePath = profile.jsonFilePath.native();
+  snapshot.isFacingRight = npc.isFacingRight();
+  snapshot.shouldShowDuringDawn = npc.shouldShowDuringDawn();
+  snapshot.shouldShowDuringDay = npc.shouldShowDuringDay();
+  snapshot.shouldShowDuringDusk = npc.shouldShowDuringDusk();
+  snapshot.shouldShowDuringNight = npc.shouldShowDuringNight();
+  snapshot.health = profile.health;
+  snapshot.magicka = profile.magicka;
+  snapshot.stamina = profile.stamina;
+  return snapshot;
+}
+
+void WorldStreamer::pin(const Vec2& pos) {
+  getChunk(pos).isPinned = true;
+}
+
+vector<string> WorldStreamer::getReport() const {
+  int numNpcSnapshots = 0;
+  int numItemSnapshots = 0;
+  for (const auto& chunk : _chunks) {
+    numNpcSnapshots += static_cast<int>(chunk.npcs.size());
+    numItemSnapshots += static_cast<int>(chunk.items.size());
+  }
+
+  return {
+    string_util::format("chunks: %d/%d loaded (%dx%d, %.0fpx)", _numLoadedChunks,
+                        static_cast<int>(_chunks.size()), _numCols, _numRows, kChunkSize),
+    string_util::format("static bodies: %d/%d live", _numLiveStaticBodies,
+                        static_cast<int>(_staticBodies.size())),
+    string_util::format("snapshots: %d npcs, %d items", numNpcSnapshots, numItemSnapshots),
+    string_util::format("chunk loads: %d, unloads: %d",
+                        static_cast<int>(_numChunkLoads), static_cast<int>(_numChunkUnloads)),
+  };
+}
+
+void WorldStreamer::loadChunk(Chunk& chunk) {
+  // The ground comes first, so that nothing falls through it.
+  for (const auto staticBodyIdx : chunk.staticBodyIdxs) {
+    retainStaticBody(_staticBodies[staticBodyIdx]);
+  }
+
+  for (const auto& desc : chunk.staticObjects) {
+    auto staticObject = std::make_shared<StaticObject>(desc.textureResDir, desc.framesName,
+                                                       desc.frameInterval, desc.isFlipped, desc.zOrder);
+    chunk.loadedStaticObjects.push_back(_gameMap.showStaticActor(std::move(staticObject), desc.pos.x, desc.pos.y));
+  }
+
+  for (const auto& desc : chunk.chests) {
+    auto chest = std::make_shared<Chest>(_gameMap.getTmxTiledMapFilePath(), desc.chestId, desc.items);
+    chunk.loadedChests.push_back(_gameMap.showDynamicActor(std::move(chest), desc.pos.x, desc.pos.y));
+  }
+
+  for (const auto& snapshot : chunk.npcs) {
+    spawnNpc(snapshot);
+  }
+  chunk.npcs.clear();
+
+  for (const auto& snapshot : chunk.items) {
+    Item* item = _gameMap.showDynamicActor<Item>(Item::create(snapshot.jsonFilePath), snapshot.pos.x, snapshot.pos.y);
+    item->setAmount(snapshot.amount);
+  }
+  chunk.items.clear();
+
+  chunk.isLoaded = true;
+  _numLoadedChunks++;
+  _numChunkLoads++;
+}
+
+void WorldStreamer::unloadChunk(Chunk& chunk) {
+  // The npcs and items in this chunk are taken care of by sweepDynamicActors().
+  for (auto staticObject : chunk.loadedStaticObjects) {
+    _gameMap.removeStaticActor(staticObject);
+  }
+  chunk.loadedStaticObjects.clear();
+
+  for (auto chest : chunk.loadedChests) {
+    _gameMap.removeDynamicActor(chest);
+  }
+  chunk.loadedChests.clear();
+
+  for (const auto staticBodyIdx : chunk.staticBodyIdxs) {
+    releaseStaticBody(_staticBodies[staticBodyIdx]);
+  }
+
+  chunk.isLoaded = false;
+  _numLoadedChunks--;
+  _numChunkUnloads++;
+}
+
+void WorldStreamer::spawnNpc(const NpcSnapshot& snapshot) {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  if (!gmMgr->isNpcAllowedToSpawn(snapshot.jsonFilePath)) {
+    return;
+  }
+
+  auto npc = std::make_shared<Npc>(snapshot.jsonFilePath);
+  npc->setInstanceId(snapshot.instanceId);
+  npc->setShowDuringDawn(snapshot.shouldShowDuringDawn);
+  npc->setShowDuringDay(snapshot.shouldShowDuringDay);
+  npc->setShowDuringDusk(snapshot.shouldShowDuringDusk);
+  npc->setShowDuringNight(snapshot.shouldShowDuringNight);
+  if (snapshot.isFacingRight.has_value()) {
+    npc->setFacingRight(snapshot.isFacingRight.value());
+  }
+
+  Character::Profile& profile = npc->getCharacterProfile();
+  profile.health = snapshot.health.value_or(profile.health);
+  profile.magicka = snapshot.magicka.value_or(profile.magicka);
+  profile.stamina = snapshot.stamina.value_or(profile.stamina);
+  _gameMap.showDynamicActor(std::move(npc), snapshot.pos.x, snapshot.pos.y);
+}
+
+void WorldStreamer::retainStaticBody(StaticBody& staticBody) {
+  if (staticBody.numLoadedChunks++ > 0) {
+    return;
+  }
+
+  const StaticBodyDesc& desc = staticBody.desc;
+  B2BodyBuilder bodyBuilder{_world};
+  if (desc.vertices.empty()) {
+    staticBody.body = bodyBuilder.type(b2BodyType::b2_staticBody)
+      .position(desc.bounds.getMidX(), desc.bounds.getMidY(), kPpm)
+      .buildBody();
+
+    bodyBuilder.newRectangleFixture(desc.bounds.size.width / 2, desc.bounds.size.height / 2, kPpm)
+      .categoryBits(desc.categoryBits)
+      .setSensor(!desc.isCollidable)
+      .friction(desc.friction)
+      .buildFixture();
+  } else {
+    staticBody.body = bodyBuilder.type(b2BodyType::b2_staticBody)
+      .position(0, 0, kPpm)
+      .buildBody();
+
+    bodyBuilder.newPolylineFixture(desc.vertices.data(), desc.vertices.size(), kPpm)
+      .categoryBits(desc.categoryBits)
+      .setSensor(!desc.isCollidable)
+      .friction(desc.friction)
+      .buildFixture();
+  }
+
+  if (desc.isPlatform) {
+    _platformBodies.push_back(staticBody.body);
+  }
+  _numLiveStaticBodies++;
+}
+
+void WorldStreamer::releaseStaticBody(StaticBody& staticBody) {
+  if (--staticBody.numLoadedChunks > 0) {
+    return;
+  }
+
+  if (staticBody.desc.isPlatform) {
+    _platformBodies.remove(staticBody.body);
+  }
+  _world->DestroyBody(staticBody.body);
+  staticBody.body = nullptr;
+  _numLiveStaticBodies--;
+}
+
+void WorldStreamer::sweepDynamicActors() {
+  vector<DynamicActor*> actors;
+  vector<Chunk*> chunksToLoad;
+  for (const auto& actor : _gameMap.getDynamicActors()) {
+    if (!isStreamed(actor.get())) {
+      continue;
+    }
+    Chunk& chunk = getChunk(actor->getBodySprite()->getPosition());
+    if (chunk.isLoaded) {
+      continue;
+    }
+
+    // One which has wandered off in the middle of something gets its ground back instead.
+    if (canSweep(actor.get())) {
+      actors.push_back(actor.get());
+    } else {
+      chunksToLoad.push_back(&chunk);
+    }
+  }
+
+  for (auto chunk : chunksToLoad) {
+    if (!chunk->isLoaded) {
+      loadChunk(*chunk);
+    }
+  }
+
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  for (auto actor : actors) {
+    // It may share its chunk with one of those above.
+    Chunk& chunk = getChunk(actor->getBodySprite()->getPosition());
+    if (chunk.isLoaded) {
+      continue;
+    }
+
+    if (auto item = dynamic_cast<Item*>(actor)) {
+      const b2Vec2& pos = item->getBody()->GetPosition();
+      chunk.items.push_back({{pos.x * kPpm, pos.y * kPpm}, item->getItemProfile().jsonFilePath.native(),
+                             item->getAmount()});
+      _gameMap.removeDynamicActor(item);
+      continue;
+    }
+
+    auto npc = static_cast<Npc*>(actor);
+    if (npc->isKilled()) {
+      _gameMap.removeDynamicActor(npc);
+      continue;
+    }
+
+    // Nobody can still be locked on to it after it is gone.
+    auto releaseLockOn = [npc](Character* character) {
+      if (character->getLockedOnTarget() == npc) {
+        character->setLockedOnTarget(nullptr);
+      }
+    };
+    if (Player* player = gmMgr->getPlayer()) {
+      releaseLockOn(player);
+      for (auto ally : player->getAllies()) {
+        releaseLockOn(ally);
+      }
+    }
+    for (const auto& other : _gameMap.getDynamicActors()) {
+      if (auto character = dynamic_cast<Character*>(other.get())) {
+        releaseLockOn(character);
+      }
+    }
+
+    chunk.npcs.push_back(makeNpcSnapshot(*npc));
+    _gameMap.removeDynamicActor(npc);
+  }
+}
+
+bool WorldStreamer::isStreamed(const DynamicActor* actor) const {
+  if (!actor->getBodySprite()) {
+    return false;
+  }
+
+  if (const auto npc = dynamic_cast<const Npc*>(actor)) {
+    return npc->isKilled() || npc->getBody();
+  }
+  const auto item = dynamic_cast<const Item*>(actor);
+  return item && item->getBody();
+}
+
+bool WorldStreamer::canSweep(const DynamicActor* actor) const {
+  const auto npc = dynamic_cast<const Npc*>(actor);
+  if (!npc) {
+    return true;
+  }
+
+  // A boss must never vanish in the middle of its fight, wherever it is.
+  if (_gameMap.isInBossFight()) {
+    return false;
+  }
+  // The killed ones may still be about to drop their items.
+  return npc->isKilled() ? !npc->hasPendingCallbacks() : isAtRest(npc);
+}
+
+WorldStreamer::Chunk& WorldStreamer::getChunk(const Vec2& pos) {
+  const auto [col, row] = getChunkCoordinate(pos);
+  return _chunks[row * _numCols + col];
+}
+
+pair<int, int> WorldStreamer::getChunkCoordinate(const Vec2& pos) const {
+  // Anything beyond the edges of the map belongs to the outermost chunks.
+  const int col = std::clamp(static_cast<int>(std::floor(pos.x / kChunkSize)), 0, _numCols - 1);
+  const int row = std::clamp(static_cast<int>(std::floor(pos.y / kChunkSize)), 0, _numRows - 1);
+  return {col, row};
+}
+
+Rect WorldStreamer::getChunkRect(const int col, const int row) const {
+  return {col * kChunkSize, row * kChunkSize, kChunkSize, kChunkSize};
+}
+
+}  // namespace requiem
@@ -0,0 +1,170 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_MAP_WORLD_STREAMER_H_
+#define REQUIEM_MAP_WORLD_STREAMER_H_
+
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <axmol.h>
+
+#include <box2d/box2d.h>
+
+namespace requiem {
+
+class GameMap;
+class StaticActor;
+class DynamicActor;
+class Npc;
+
+// Splits the static bodies, animated objects, chests, npcs and items of a game
+// map into fixed-size chunks, and only keeps the chunks around the player loaded.
+//
+// The content of each chunk is prepared as plain data while the game map is
+// being loaded, and committed to the b2World and the scene graph once the chunk
+// comes into range. The chunks on screen are loaded right away, and the ones
+// around it at most kMaxNumChunksLoadedPerFrame per frame. A chunk is unloaded
+// only after it is kUnloadMargin away, which is farther than it is loaded at,
+// so walking back and forth across a chunk border doesn't thrash it.
+//
+// The npcs and items in an unloaded chunk are kept as snapshots, and are
+// re-created from them when the chunk is loaded again. An npc which can't be
+// turned into a snapshot yet, e.g., in the middle of an attack, keeps the chunk
+// it is in loaded instead, so that it never falls through the world.
+class WorldStreamer final {
+ public:
+  struct StaticBodyDesc final {
+    ax::Rect bounds;  // in pixels
+    std::vector<b2Vec2> vertices;  // in pixels, or empty if this is a rectangle spanning `bounds`.
+    short categoryBits{};
+    bool isCollidable{};
+    bool isPlatform{};
+    float friction{};
+  };
+
+  struct StaticObjectDesc final {
+    ax::Vec2 pos;
+    std::string textureResDir;
+    std::string framesName;
+    float frameInterval{};
+    bool isFlipped{};
+    int zOrder{};
+  };
+
+  struct ChestDesc final {
+    ax::Vec2 pos;
+    int chestId{};
+    std::string items;
+  };
+
+  struct NpcSnapshot final {
+    uint32_t instanceId{};  // see Npc::getInstanceId().
+    ax::Vec2 pos;
+    std::string jsonFilePath;
+    std::optional<bool> isFacingRight;
+    bool shouldShowDuringDawn{true};
+    bool shouldShowDuringDay{true};
+    bool shouldShowDuringDusk{true};
+    bool shouldShowDuringNight{true};
+    std::optional<int> health;  // std::nullopt if it has never been loaded.
+    std::optional<int> magicka;
+    std::optional<int> stamina;
+  };
+
+  struct ItemSnapshot final {
+    ax::Vec2 pos;
+    std::string jsonFilePath;
+    int amount{};
+  };
+
+  WorldStreamer(b2World* world, GameMap& gameMap, const ax::Size& mapSize);
+  ~WorldStreamer();
+  WorldStreamer(const WorldStreamer&) = delete;
+  WorldStreamer& operator=(const WorldStreamer&) = delete;
+
+  // Loads the chunks around `focus` and unloads the ones far away from it.
+  // @param shouldLoadAllInRange: load all of the chunks in range at once
+  //                              rather than at most kMaxNumChunksLoadedPerFrame.
+  void update(const ax::Vec2& focus, const bool shouldLoadAllInRange = false);
+
+  void addStaticBody(StaticBodyDesc&& desc);
+  void addStaticObject(StaticObjectDesc&& desc);
+  void addChest(ChestDesc&& desc);
+  void addNpc(NpcSnapshot&& snapshot);
+
+  // Puts the npc back as described by the snapshot, replacing the snapshot
+  // with the same instance id if any. It is spawned right away if its chunk is loaded.
+  void restoreNpc(NpcSnapshot&& snapshot);
+  std::vector<NpcSnapshot> getNpcSnapshots() const;
+  static NpcSnapshot makeNpcSnapshot(Npc& npc);
+
+  // Keeps the chunk at `pos` loaded from the next update() on,
+  // for as long as this game map is.
+  void pin(const ax::Vec2& pos);
+
+  std::vector<std::string> getReport() const;
+
+  inline const std::list<b2Body*>& getPlatformBodies() const { return _platformBodies; }
+
+  static inline constexpr float kChunkSize = 512.0f;
+  static inline constexpr float kLoadMargin = 256.0f;
+  static inline constexpr float kUnloadMargin = 768.0f;
+  static inline constexpr int kMaxNumChunksLoadedPerFrame = 1;
+
+ private:
+  struct Chunk final {
+    std::vector<size_t> staticBodyIdxs;  // may be shared with the neighbouring chunks.
+    std::vector<StaticObjectDesc> staticObjects;
+    std::vector<ChestDesc> chests;
+    std::vector<NpcSnapshot> npcs;
+    std::vector<ItemSnapshot> items;
+
+    std::vector<StaticActor*> loadedStaticObjects;
+    std::vector<DynamicActor*> loadedChests;
+    bool isLoaded{};
+    bool isPinned{};
+  };
+
+  struct StaticBody final {
+    StaticBodyDesc desc;
+    b2Body* body{};
+    int numLoadedChunks{};
+  };
+
+  void loadChunk(Chunk& chunk);
+  void unloadChunk(Chunk& chunk);
+  void spawnNpc(const NpcSnapshot& snapshot);
+  void retainStaticBody(StaticBody& staticBody);
+  void releaseStaticBody(StaticBody& staticBody);
+
+  // Moves the npcs and items which are in the unloaded chunks into their snapshots,
+  // and loads the chunks of those which can't be moved yet.
+  void sweepDynamicActors();
+  bool isStreamed(const DynamicActor* actor) const;
+  bool canSweep(const DynamicActor* actor) const;
+
+  Chunk& getChunk(const ax::Vec2& pos);
+  std::pair<int, int> getChunkCoordinate(const ax::Vec2& pos) const;
+  ax::Rect getChunkRect(const int col, const int row) const;
+
+  b2World* _world;
+  GameMap& _gameMap;
+  int _numCols{};
+  int _numRows{};
+  std::vector<Chunk> _chunks;
+  std::vector<StaticBody> _staticBodies;
+  std::list<b2Body*> _platformBodies;
+
+  int _numLoadedChunks{};
+  int _numLiveStaticBodies{};
+  size_t _numChunkLoads{};
+  size_t _numChunkUnloads{};
+};
+
+}  // namespace requiem
+
+#endif  // REQUIEM_MAP_WORLD_STREAMER_H_
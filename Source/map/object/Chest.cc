@@ -5,6 +5,7 @@
 #include "Assets.h"
 #include "Audio.h"
 #include "Constants.h"
+#include "TextureManager.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
 #include "util/AxUtil.h"
@@ -52,11 +53,10 @@ bool Chest::showOnMap(float x, float y) {
              kItemCategoryBits,
              kItemMaskBits);
 
-  if (!_isOpened) {
-    _bodySprite = Sprite::create("Texture/interactable_object/chest/chest_close.png");
-  } else {
-    _bodySprite = Sprite::create("Texture/interactable_object/chest/chest_open.png");
-  }
+  const string textureFilePath = (!_isOpened) ? "Texture/interactable_object/chest/chest_close.png" :
+                                                "Texture/interactable_object/chest/chest_open.png";
+  TextureManager::the().acquire(textureFilePath, TextureManager::Category::OBJECT);
+  _bodySprite = Sprite::create(textureFilePath);
   _bodySprite->getTexture()->setAliasTexParameters();
   _node->addChild(_bodySprite, z_order::kChest);
 
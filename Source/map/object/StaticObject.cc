@@ -4,6 +4,8 @@
 
 #include "Assets.h"
 #include "Constants.h"
+#include "FrameClock.h"
+#include "TextureManager.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
 #include "util/AxUtil.h"
@@ -13,12 +15,19 @@ USING_NS_AX;
 
 namespace requiem {
 
+namespace {
+
+constexpr int kAnimationActionTag = 1;
+
+}  // namespace
+
 bool StaticObject::showOnMap(float x, float y) {
   if (_isShownOnMap) {
     return false;
   }
 
   _isShownOnMap = true;
+  _isCulled = false;
 
   defineTexture();
   _bodySprite->setPosition(x, y);
@@ -40,22 +49,48 @@ void StaticObject::defineTexture() {
   //  textureResDir    |  framesName
   //            framesNamePrefix
   const string framesNamePrefix = StaticActor::getLastDirName(_textureResDir);
+  const string spritesheetFilePath = StaticActor::getSpritesheetFilePath(_textureResDir);
+  TextureManager::the().acquire(spritesheetFilePath, TextureManager::Category::OBJECT);
 
   // Select the first frame (e.g., dust_white/0.png) as the default look of the sprite.
   _bodySprite = Sprite::createWithSpriteFrameName(framesNamePrefix + "_" + _framesName + "/0.png");
 
-  const string spritesheetFilePath = StaticActor::getSpritesheetFilePath(_textureResDir);
   _bodySpritesheet = SpriteBatchNode::create(spritesheetFilePath);
   _bodySpritesheet->addChild(_bodySprite);
   _bodySpritesheet->getTexture()->setAliasTexParameters();
 
   Animation* animation = StaticActor::createAnimation(_textureResDir, _framesName, _frameInterval / kPpm);
   auto animate = Animate::create(animation);
-  _bodySprite->runAction(RepeatForever::create(animate));
+  Action* action = _bodySprite->runAction(RepeatForever::create(animate));
+  action->setTag(kAnimationActionTag);
+  // The action holds its own reference to the animation.
+  animation->release();
 
   if (_flipped) {
     _bodySprite->setFlippedX(true);
   }
 }
 
+void StaticObject::setCulled(const bool culled) {
+  if (!_bodySprite || culled == _isCulled) {
+    return;
+  }
+
+  _isCulled = culled;
+
+  if (culled) {
+    _bodySprite->pause();
+    _culledAtGameTimeMs = FrameClock::the().getGameTimeMs();
+    return;
+  }
+
+  _bodySprite->resume();
+
+  // Catch up with the time elapsed while culled, so that this object doesn't
+  // resume at the exact frame where it left off.
+  if (Action* action = _bodySprite->getActionByTag(kAnimationActionTag)) {
+    action->step((FrameClock::the().getGameTimeMs() - _culledAtGameTimeMs) / 1000.0f);
+  }
+}
+
 }  // namespace requiem
@@ -3,6 +3,7 @@
 #ifndef REQUIEM_MAP_OBJECT_STATIC_OBJECT_H_
 #define REQUIEM_MAP_OBJECT_STATIC_OBJECT_H_
 
+#include <cstdint>
 #include <string>
 
 #include <axmol.h>
@@ -27,6 +28,7 @@ class StaticObject : public StaticActor {
   virtual ~StaticObject() override = default;
 
   virtual bool showOnMap(float x, float y) override;  // StaticActor
+  virtual void setCulled(const bool culled) override;  // StaticActor
 
  private:
   void defineTexture();
@@ -36,6 +38,8 @@ class StaticObject : public StaticActor {
   const float _frameInterval;
   const bool _flipped;
   const int _zOrder;
+  bool _isCulled{};
+  uint64_t _culledAtGameTimeMs{};
 };
 
 }  // namespace requiem
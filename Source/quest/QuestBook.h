@@ -15,6 +15,7 @@ namespace requiem {
 
 class QuestBook final {
  public:
+  friend class Checkpoint;
   friend class GameState;
   
   QuestBook();
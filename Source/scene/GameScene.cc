@@ -5,6 +5,7 @@
 #include "Assets.h"
 #include "CallbackManager.h"
 #include "Constants.h"
+#include "FrameClock.h"
 #include "character/Player.h"
 #include "gameplay/ExpPointTable.h"
 #include "gameplay/GameState.h"
@@ -12,6 +13,7 @@
 #include "skill/Skill.h"
 #include "quest/Quest.h"
 #include "util/CameraUtil.h"
+#include "util/FrameArena.h"
 #include "util/KeyCodeUtil.h"
 #include "util/RandUtil.h"
 #include "util/Logger.h"
@@ -41,7 +43,8 @@ bool GameScene::init() {
   _hotkeyManager = std::make_unique<HotkeyManager>();
 
   // Initialize CallbackManager.
-  CallbackManager::the().setScene(this);
+  // Drop the callbacks left behind by the previous GameScene (if any).
+  CallbackManager::the().clear();
 
   // Initialize requiem's utils.
   requiem::keycode_util::init();
@@ -121,6 +124,16 @@ bool GameScene::init() {
   _floatingDamages->getLayer()->setCameraMask(camera::kGameCameraMask);
   addChild(_floatingDamages->getLayer(), z_order::kFloatingDamage);
 
+  // Initialize floating health bars.
+  _floatingHealthBars = std::make_unique<FloatingHealthBars>();
+  _floatingHealthBars->getLayer()->setCameraMask(camera::kGameCameraMask);
+  addChild(_floatingHealthBars->getLayer(), z_order::kFloatingHealthBar);
+
+  // Initialize debug overlay.
+  _debugOverlay = std::make_unique<DebugOverlay>();
+  _debugOverlay->getLayer()->setCameraMask(camera::kGameCameraMask);
+  addChild(_debugOverlay->getLayer(), z_order::kDebugOverlay);
+
   // Initialize control hints.
   _controlHints = std::make_unique<ControlHints>();
   _controlHints->getLayer()->setCameraMask(camera::kHudCameraMask);
@@ -177,6 +190,10 @@ bool GameScene::init() {
   _drawBox2D->setVisible(false);
   addChild(_drawBox2D);
 
+  // Initialize tick registry.
+  _tickRegistry = std::make_unique<TickRegistry>();
+  registerSubsystems();
+
   // Tick the box2d world.
   schedule(AX_SCHEDULE_SELECTOR(GameScene::update));
 
@@ -184,6 +201,10 @@ bool GameScene::init() {
 }
 
 void GameScene::update(const float delta) {
+  // Reclaim everything allocated (and drawn for debugging) for the previous frame.
+  FrameArena::resetAll();
+  _debugOverlay->beginFrame();
+
   if (!_isActive) {
     if (_isTerminating) {
       return;
@@ -202,34 +223,82 @@ void GameScene::update(const float delta) {
 
   handleInput();
 
-  if (_pauseMenu->isVisible()) {
+  FrameClock& frameClock = FrameClock::the();
+  frameClock.setPaused(_pauseMenu->isVisible());
+  frameClock.tick(delta);
+
+  if (frameClock.isPaused()) {
     return;
   }
 
+  _tickRegistry->tick(TickRegistry::Phase::PRE_PHYSICS);
+
   // If there are no ongoing GameMap transitions, then step the box2d world.
   if (_shade->getImageView()->getNumberOfRunningActions() == 0) {
-    _gameMapManager->getWorld()->Step(1.0f / kFps, kVelocityIterations, kPositionIterations);
+    _gameMapManager->getWorld()->Step(frameClock.getTimeScale() / kFps, kVelocityIterations, kPositionIterations);
   }
 
-  _inGameTime->update(delta);
-  _timeLocationInfo->update();
-  _gameMapManager->update(delta);
-  _afterImageFxManager->update(delta);
-  _floatingDamages->update(delta);
-  _notifications->update(delta);
-  _questHints->update(delta);
-  _dialogueManager->update(delta);
-  _console->update(delta);
-  _windowManager->update(delta);
-
-  if (_drawBox2D->isVisible()) {
-    _drawBox2D->clear();
-    _gameMapManager->getWorld()->DebugDraw();
-  }
+  _tickRegistry->tick(TickRegistry::Phase::POST_PHYSICS);
+  _tickRegistry->tick(TickRegistry::Phase::LATE);
+}
 
-  camera_util::lerpToTarget(_gameCamera, _gameMapManager->getPlayer()->getBody()->GetPosition());
-  camera_util::boundCamera(_gameCamera, _gameMapManager->getGameMap());
-  camera_util::updateShake(_gameCamera, delta);
+void GameScene::registerSubsystems() {
+  using Phase = TickRegistry::Phase;
+
+  // The gameplay subsystems follow the game time, whereas the UI follows the real time.
+  _tickRegistry->add("inGameTime", Phase::PRE_PHYSICS, 0, false,
+                     [this](const float delta) { _inGameTime->update(delta); });
+
+  _tickRegistry->add("callbacks", Phase::POST_PHYSICS, 0, false,
+                     [](const float delta) { CallbackManager::the().update(delta); },
+                     []() { return CallbackManager::the().getNumPendingCallbacks() > 0; });
+  _tickRegistry->add("timeLocationInfo", Phase::POST_PHYSICS, 10, false,
+                     [this](const float) { _timeLocationInfo->update(); });
+  _tickRegistry->add("gameMap", Phase::POST_PHYSICS, 20, false,
+                     [this](const float delta) { _gameMapManager->update(delta); });
+  _tickRegistry->add("fx", Phase::POST_PHYSICS, 30, false,
+                     [this](const float delta) { _fxManager->update(delta); },
+                     [this]() { return _fxManager->hasActiveFx(); });
+  _tickRegistry->add("afterImageFx", Phase::POST_PHYSICS, 40, false,
+                     [this](const float delta) { _afterImageFxManager->update(delta); },
+                     [this]() { return !_afterImageFxManager->isEmpty(); });
+  _tickRegistry->add("floatingDamages", Phase::POST_PHYSICS, 50, false,
+                     [this](const float delta) { _floatingDamages->update(delta); },
+                     [this]() { return _floatingDamages->hasActiveDamageLabels(); });
+  _tickRegistry->add("floatingHealthBars", Phase::POST_PHYSICS, 60, false,
+                     [this](const float delta) { _floatingHealthBars->update(delta); },
+                     [this]() { return _floatingHealthBars->hasActiveHealthBars(); });
+
+  _tickRegistry->add("notifications", Phase::LATE, 0, true,
+                     [this](const float delta) { _notifications->update(delta); },
+                     [this]() { return !_notifications->isEmpty(); });
+  _tickRegistry->add("questHints", Phase::LATE, 10, true,
+                     [this](const float delta) { _questHints->update(delta); },
+                     [this]() { return !_questHints->isEmpty(); });
+  _tickRegistry->add("dialogue", Phase::LATE, 20, true,
+                     [this](const float delta) { _dialogueManager->update(delta); },
+                     [this]() { return _dialogueManager->getSubtitles()->getLayer()->isVisible(); });
+  _tickRegistry->add("console", Phase::LATE, 30, true,
+                     [this](const float delta) { _console->update(delta); },
+                     [this]() { return _console->getLayer()->isVisible(); });
+  _tickRegistry->add("windows", Phase::LATE, 40, true,
+                     [this](const float delta) { _windowManager->update(delta); },
+                     [this]() { return !_windowManager->isEmpty(); });
+  _tickRegistry->add("box2dDebugDraw", Phase::LATE, 50, true,
+                     [this](const float) {
+                       _drawBox2D->clear();
+                       _gameMapManager->getWorld()->DebugDraw();
+                     },
+                     [this]() { return _drawBox2D->isVisible(); });
+  _tickRegistry->add("camera", Phase::LATE, 60, true, [this](const float delta) {
+    // The killed player has no body until it is restored from the checkpoint,
+    // so the camera holds still in the meantime.
+    if (const b2Body* playerBody = _gameMapManager->getPlayer()->getBody()) {
+      camera_util::lerpToTarget(_gameCamera, playerBody->GetPosition());
+    }
+    camera_util::boundCamera(_gameCamera, _gameMapManager->getGameMap());
+    camera_util::updateShake(_gameCamera, delta);
+  });
 }
 
 void GameScene::handleInput() {
@@ -15,6 +15,7 @@
 #include "AfterImageFxManager.h"
 #include "Controllable.h"
 #include "FxManager.h"
+#include "TickRegistry.h"
 #include "gameplay/DialogueManager.h"
 #include "gameplay/InGameTime.h"
 #include "gameplay/RoomRentalTracker.h"
@@ -22,8 +23,10 @@
 #include "input/InputManager.h"
 #include "map/GameMapManager.h"
 #include "ui/console/Console.h"
+#include "ui/DebugOverlay.h"
 #include "ui/hud/ControlHints.h"
 #include "ui/hud/FloatingDamages.h"
+#include "ui/hud/FloatingHealthBars.h"
 #include "ui/hud/Hud.h"
 #include "ui/hud/TimeLocationInfo.h"
 #include "ui/hud/Notifications.h"
@@ -63,6 +66,8 @@ class GameScene final : public ax::Scene, public Controllable {
   inline ControlHints* getControlHints() const { return _controlHints.get(); }
   inline DialogueManager* getDialogueManager() const { return _dialogueManager.get(); }
   inline FloatingDamages* getFloatingDamages() const { return _floatingDamages.get(); }
+  inline FloatingHealthBars* getFloatingHealthBars() const { return _floatingHealthBars.get(); }
+  inline DebugOverlay* getDebugOverlay() const { return _debugOverlay.get(); }
   inline QuestHints* getQuestHints() const { return _questHints.get(); }
   inline Notifications* getNotifications() const { return _notifications.get(); }
   inline GameMapManager* getGameMapManager() const { return _gameMapManager.get(); }
@@ -70,8 +75,11 @@ class GameScene final : public ax::Scene, public Controllable {
   inline AfterImageFxManager* getAfterImageFxManager() const { return _afterImageFxManager.get(); }
   inline InGameTime* getInGameTime() const { return _inGameTime.get(); }
   inline RoomRentalTracker* getRoomRentalTracker() const { return _roomRentalTracker.get(); }
+  inline TickRegistry* getTickRegistry() const { return _tickRegistry.get(); }
 
  private:
+  void registerSubsystems();
+
   bool _isActive;
   bool _isTerminating;
 
@@ -89,6 +97,8 @@ class GameScene final : public ax::Scene, public Controllable {
   std::unique_ptr<Notifications> _notifications;
   std::unique_ptr<QuestHints> _questHints;
   std::unique_ptr<FloatingDamages> _floatingDamages;
+  std::unique_ptr<FloatingHealthBars> _floatingHealthBars;
+  std::unique_ptr<DebugOverlay> _debugOverlay;
   std::unique_ptr<ControlHints> _controlHints;
   std::unique_ptr<DialogueManager> _dialogueManager;
   std::unique_ptr<WindowManager> _windowManager;
@@ -98,6 +108,7 @@ class GameScene final : public ax::Scene, public Controllable {
   std::unique_ptr<PauseMenu> _pauseMenu;
   std::unique_ptr<InGameTime> _inGameTime;
   std::unique_ptr<RoomRentalTracker> _roomRentalTracker;
+  std::unique_ptr<TickRegistry> _tickRegistry;
 };
 
 }  // namespace requiem
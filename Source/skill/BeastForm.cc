@@ -32,7 +32,7 @@ bool BeastForm::canActivate() {
 void BeastForm::activate() {
   _hasActivated = true;
 
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  _user->runAfter([this](const CallbackManager::CallbackId) {
     _originalCharacterProfile = _user->getCharacterProfile();
     _user->replaceSpritesheet("Data/character/werewolf.json");
     _user->runIntroAnimation();
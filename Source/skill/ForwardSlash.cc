@@ -53,15 +53,15 @@ void ForwardSlash::activate() {
   _user->getFixtures()[Character::FixtureType::BODY]->SetSensor(true);
 
   auto afterImageFxMgr = SceneManager::the().getCurrentScene<GameScene>()->getAfterImageFxManager();
-  afterImageFxMgr->registerNode(_user->getNode(), AfterImageFxManager::kPlayerAfterImageColor, 0.15f, 0.05f);
+  afterImageFxMgr->registerActor(_user, AfterImageFxManager::kPlayerAfterImageColor, 0.15f, 0.05f);
 
-  CallbackManager::the().runAfter([this, oldGravityScale](const CallbackManager::CallbackId) {
+  _user->runAfter([this, oldGravityScale](const CallbackManager::CallbackId) {
     _user->getBody()->SetGravityScale(oldGravityScale);
   }, _skillProfile.framesDuration / 4);
 
-  CallbackManager::the().runAfter([this, oldBodyDamping](const CallbackManager::CallbackId) {
+  _user->runAfter([this, oldBodyDamping](const CallbackManager::CallbackId) {
     auto afterImageFxMgr = SceneManager::the().getCurrentScene<GameScene>()->getAfterImageFxManager();
-    afterImageFxMgr->unregisterNode(_user->getNode());
+    afterImageFxMgr->unregisterActor(_user);
 
     _user->getBody()->SetLinearDamping(oldBodyDamping);
     _user->setInvincible(false);
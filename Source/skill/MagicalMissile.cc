@@ -8,6 +8,7 @@
 #include "Audio.h"
 #include "CallbackManager.h"
 #include "Constants.h"
+#include "TextureManager.h"
 #include "character/Character.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
@@ -46,13 +47,21 @@ bool MagicalMissile::showOnMap(float x, float y) {
 
   _isShownOnMap = true;
 
-  defineBody(b2BodyType::b2_kinematicBody, x, y,
-             kMagicalMissleCategoryBits,
-             kMagicalMissleMaskBits);
+  if (!_body) {
+    defineBody(b2BodyType::b2_kinematicBody, x, y,
+               kMagicalMissleCategoryBits,
+               kMagicalMissleMaskBits);
 
-  defineTexture(_skillProfile.textureResDirPath, x, y);
+    defineTexture(_skillProfile.textureResDirPath, x, y);
 
-  _node->addChild(_bodySpritesheet, z_order::kSpell);
+    _node->addChild(_bodySpritesheet, z_order::kSpell);
+  } else {
+    // This instance is being reused from ProjectilePool.
+    float spellOffset = _user->getCharacterProfile().attackRange / kPpm;
+    spellOffset = (_user->isFacingRight()) ? spellOffset : -spellOffset;
+    _body->SetTransform({x + spellOffset, y}, 0);
+    _body->SetEnabled(true);
+  }
 
   auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
   ax_util::addChildWithParentCameraMask(gmMgr->getLayer(), _node, z_order::kSpell);
@@ -60,6 +69,26 @@ bool MagicalMissile::showOnMap(float x, float y) {
   return true;
 }
 
+bool MagicalMissile::removeFromMap() {
+  if (!_isShownOnMap) {
+    return false;
+  }
+
+  _isShownOnMap = false;
+
+  // Keep the body, sprites and animations around so that this instance
+  // can be reused, but take the body out of the simulation.
+  _body->SetLinearVelocity({0, 0});
+  _body->SetEnabled(false);
+  _bodySprite->stopAllActions();
+  _launchFxSprite->stopAllActions();
+  _launchFxSprite->setVisible(false);
+
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  gmMgr->getLayer()->removeChild(_node, true);
+  return true;
+}
+
 void MagicalMissile::update(const float delta) {
   if (_hasHit) {
     return;
@@ -95,8 +124,9 @@ void MagicalMissile::onHit(Character* target) {
   _bodySprite->runAction(Sequence::createWithTwoActions(
     Animate::create(_bodyAnimations[AnimationType::ON_HIT]),
     CallFunc::create([this, gmMgr]() {
-      gmMgr->getGameMap()->removeDynamicActor(this);
+      shared_ptr<MagicalMissile> self = gmMgr->getGameMap()->removeDynamicActor<MagicalMissile>(this);
       _user->removeActiveSkillInstance(this);
+      gmMgr->getProjectilePool()->release(std::move(self));
     })
   ));
 
@@ -104,11 +134,10 @@ void MagicalMissile::onHit(Character* target) {
     const bool isFacingRight = _body->GetLinearVelocity().x > 0;
     const float knockBackForceX = isFacingRight ? 3.5f : -3.5f;
     const float knockBackForceY = 1.0f;
-    _user->knockBack(target, knockBackForceX, knockBackForceY);
-    _user->inflictDamage(target, getDamage());
+    gmMgr->getDamageQueue()->push({_user, target, getDamage(), {knockBackForceX, knockBackForceY}});
 
     target->setStunned(true);
-    CallbackManager::the().runAfter([target](const CallbackManager::CallbackId) {
+    target->runAfter([target](const CallbackManager::CallbackId) {
       target->setStunned(false);
     }, 2.0f);
   }
@@ -134,7 +163,7 @@ void MagicalMissile::activate() {
 
   _user->getCharacterProfile().magicka += _skillProfile.deltaMagicka;
 
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  _user->runAfter([this](const CallbackManager::CallbackId) {
     shared_ptr<Skill> activeCopy = _user->getActiveSkillInstance(this);
     auto actor = std::dynamic_pointer_cast<DynamicActor>(activeCopy);
     if (!actor) {
@@ -155,20 +184,19 @@ void MagicalMissile::activate() {
     _flyingSpeed = (_user->isFacingRight()) ? 4 : -4;
     _body->SetLinearVelocity({_flyingSpeed, 0});
 
-    if (!_user->isFacingRight()) {
-      _launchFxSprite->setFlippedX(true);
-      _bodySprite->setFlippedX(true);
-    }
+    _launchFxSprite->setFlippedX(!_user->isFacingRight());
+    _bodySprite->setFlippedX(!_user->isFacingRight());
 
     // Play the magical missile body's animation.
     _bodySprite->runAction(Animate::create(_bodyAnimations[AnimationType::FLYING]));
 
     // Play launch fx animation.
     _launchFxSprite->setPosition((x + offsetX) * kPpm, (y + offsetY) * kPpm);
+    _launchFxSprite->setVisible(true);
     _launchFxSprite->runAction(Sequence::createWithTwoActions(
       Animate::create(_bodyAnimations[AnimationType::LAUNCH_FX]),
       CallFunc::create([this]() {
-        _bodySpritesheet->removeChild(_launchFxSprite, true);
+        _launchFxSprite->setVisible(false);
       })
     ));
   }, _user->getAnimationDuration(Character::State::SPELLCAST) * 0.7f);
@@ -178,6 +206,12 @@ fs::path MagicalMissile::getIconPath() const {
   return _skillProfile.textureResDirPath / kIconPng;
 }
 
+void MagicalMissile::reset(Character* user) {
+  _user = user;
+  _hasActivated = false;
+  _hasHit = false;
+}
+
 void MagicalMissile::defineBody(b2BodyType bodyType,
                                 float x,
                                 float y,
@@ -208,6 +242,7 @@ void MagicalMissile::defineBody(b2BodyType bodyType,
 }
 
 void MagicalMissile::defineTexture(const fs::path& textureResDirPath, float x, float y) {
+  TextureManager::the().acquire(getSpritesheetFilePath(textureResDirPath), TextureManager::Category::FX);
   _bodySpritesheet = SpriteBatchNode::create((textureResDirPath / "spritesheet.png").native());
 
   _bodyAnimations[AnimationType::LAUNCH_FX] = createAnimation(textureResDirPath, "launch", 5.0f / kPpm);
@@ -29,6 +29,7 @@ class MagicalMissile final : public DynamicActor, public Skill, public Projectil
   virtual ~MagicalMissile() = default;
 
   virtual bool showOnMap(float x, float y) override;  // DynamicActor
+  virtual bool removeFromMap() override;  // DynamicActor
   virtual void update(const float delta) override;  // DynamicActor
 
   virtual Character* getUser() const override { return _user; }  // Projectile
@@ -47,6 +48,10 @@ class MagicalMissile final : public DynamicActor, public Skill, public Projectil
   virtual const std::string& getDesc() const override { return _skillProfile.desc; }  // Skill
   virtual std::filesystem::path getIconPath() const override;  // Skill
 
+  // Prepares a pooled instance to be cast again by `user`.
+  // Its body, sprites and animations are kept from the previous cast.
+  void reset(Character* user);
+
  private:
   virtual void defineBody(b2BodyType bodyType,
                           float x,
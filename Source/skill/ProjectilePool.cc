@@ -0,0 +1,72 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#include "ProjectilePool.h"
+
+#include <algorithm>
+
+#include "skill/MagicalMissile.h"
+#include "util/Logger.h"
+#include "util/StringUtil.h"
+
+namespace fs = std::filesystem;
+using namespace std;
+
+namespace requiem {
+
+shared_ptr<MagicalMissile> ProjectilePool::acquire(const fs::path& jsonFilePath, Character* user) {
+  Pool& pool = _pools[jsonFilePath.native()];
+
+  shared_ptr<MagicalMissile> projectile;
+  if (!pool.idle.empty()) {
+    projectile = std::move(pool.idle.back());
+    pool.idle.pop_back();
+    projectile->reset(user);
+    pool.numReused++;
+  } else {
+    projectile = std::dynamic_pointer_cast<MagicalMissile>(Skill::create(jsonFilePath, user));
+    if (!projectile) {
+      VGLOG(LOG_ERR, "Failed to create projectile: [%s].", jsonFilePath.c_str());
+      return nullptr;
+    }
+    pool.numCreated++;
+  }
+
+  pool.numActive++;
+  pool.peakNumActive = std::max(pool.peakNumActive, pool.numActive);
+  return projectile;
+}
+
+void ProjectilePool::release(shared_ptr<MagicalMissile> projectile) {
+  if (!projectile) {
+    return;
+  }
+
+  auto it = _pools.find(projectile->getSkillProfile().jsonFilePath.native());
+  if (it == _pools.end()) {
+    // The pools have been cleared while this projectile was still flying.
+    return;
+  }
+
+  Pool& pool = it->second;
+  pool.numActive--;
+  pool.idle.push_back(std::move(projectile));
+}
+
+void ProjectilePool::clear() {
+  _pools.clear();
+}
+
+vector<string> ProjectilePool::getReport() const {
+  vector<string> report;
+  report.push_back(string_util::format("projectile pools: %d", static_cast<int>(_pools.size())));
+  for (const auto& [jsonFilePath, pool] : _pools) {
+    report.push_back(string_util::format("%s: %d active (peak: %d), %d idle, %d created, %d reused",
+                                         fs::path{jsonFilePath}.stem().c_str(),
+                                         pool.numActive, pool.peakNumActive,
+                                         static_cast<int>(pool.idle.size()),
+                                         pool.numCreated, pool.numReused));
+  }
+  return report;
+}
+
+}  // namespace requiem
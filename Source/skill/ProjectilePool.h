@@ -0,0 +1,48 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_SKILL_PROJECTILE_POOL_H_
+#define REQUIEM_SKILL_PROJECTILE_POOL_H_
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace requiem {
+
+class Character;
+class MagicalMissile;
+
+// Keeps the projectiles which have finished flying, keyed by their skill json,
+// so that casting the same spell again reuses an instance whose body, sprites
+// and animations are already built, rather than reparsing the json and
+// recreating all of them.
+class ProjectilePool final {
+ public:
+  ProjectilePool() = default;
+  ProjectilePool(const ProjectilePool&) = delete;
+  ProjectilePool& operator=(const ProjectilePool&) = delete;
+
+  // @return: an idle projectile rebound to `user`, or a newly created one.
+  std::shared_ptr<MagicalMissile> acquire(const std::filesystem::path& jsonFilePath, Character* user);
+  void release(std::shared_ptr<MagicalMissile> projectile);
+  void clear();
+
+  std::vector<std::string> getReport() const;
+
+ private:
+  struct Pool {
+    std::vector<std::shared_ptr<MagicalMissile>> idle;
+    int numCreated{};
+    int numReused{};
+    int numActive{};
+    int peakNumActive{};
+  };
+
+  std::unordered_map<std::string, Pool> _pools;
+};
+
+}  // namespace requiem
+
+#endif  // REQUIEM_SKILL_PROJECTILE_POOL_H_
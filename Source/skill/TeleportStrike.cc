@@ -89,11 +89,11 @@ void TeleportStrike::activate() {
     return;
   }
 
-  CallbackManager::the().runAfter([this, target, targetPos, teleportDestPos](const CallbackManager::CallbackId) {
+  _user->runAfter([this, target, targetPos, teleportDestPos](const CallbackManager::CallbackId) {
     const b2Vec2 thisPos = _user->getBody()->GetPosition();
     _user->setFacingRight(teleportDestPos->x < targetPos.x);
 
-    CallbackManager::the().runAfter([this, target](const CallbackManager::CallbackId) {
+    _user->runAfter([this, target](const CallbackManager::CallbackId) {
       _user->attack(Character::State::ATTACKING_FORWARD, _user->getCharacterProfile().forwardAttackNumTimesInflictDamage);
     }, 0.1f);
 
@@ -102,7 +102,7 @@ void TeleportStrike::activate() {
     _user->setInvincible(true);
     _user->enableAfterImageFx(ax::Color3B{0xa6, 0x53, 0x72});
 
-    CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+    _user->runAfter([this](const CallbackManager::CallbackId) {
       _user->disableAfterImageFx();
       _user->setInvincible(false);
       _user->getBody()->SetAwake(true);
@@ -0,0 +1,77 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#include "DebugOverlay.h"
+
+#include "Assets.h"
+
+using namespace std;
+using namespace requiem::assets;
+USING_NS_AX;
+
+namespace requiem {
+
+namespace {
+
+constexpr array<const char*, static_cast<size_t>(DebugOverlay::Category::SIZE)> kCategoryNames{{
+  "raycast",
+  "navigation",
+}};
+
+}  // namespace
+
+DebugOverlay::DebugOverlay() : _layer{Layer::create()}, _drawNode{DrawNode::create()} {
+  _layer->addChild(_drawNode);
+
+#if REQUIEM_ENABLE_DEBUG_OVERLAY
+  _labels.reserve(kMaxNumLabels);
+  for (int i = 0; i < kMaxNumLabels; i++) {
+    Label* label = Label::createWithTTF("", string{kRegularFont}, kRegularFontSize);
+    label->getFontAtlas()->setAliasTexParameters();
+    label->setVisible(false);
+    _layer->addChild(label);
+    _labels.push_back(label);
+  }
+#endif
+}
+
+void DebugOverlay::beginFrame() {
+  if (!_hasDrawnAnything) {
+    return;
+  }
+
+  _drawNode->clear();
+  for (int i = 0; i < _numUsedLabels; i++) {
+    _labels[i]->setVisible(false);
+  }
+  _numUsedLabels = 0;
+  _hasDrawnAnything = false;
+}
+
+const char* DebugOverlay::getCategoryName(const Category category) {
+  return kCategoryNames[static_cast<size_t>(category)];
+}
+
+optional<DebugOverlay::Category> DebugOverlay::getCategoryByName(const string& name) {
+  for (size_t i = 0; i < kCategoryNames.size(); i++) {
+    if (name == kCategoryNames[i]) {
+      return static_cast<Category>(i);
+    }
+  }
+  return nullopt;
+}
+
+void DebugOverlay::doDrawText(const Vec2& pos, string_view text, const Color4F& color) {
+  // Text beyond the pool's capacity is dropped for this frame.
+  if (_numUsedLabels >= static_cast<int>(_labels.size())) {
+    return;
+  }
+
+  Label* label = _labels[_numUsedLabels++];
+  label->setString(text);
+  label->setTextColor(Color4B{color});
+  label->setPosition(pos);
+  label->setVisible(true);
+  _hasDrawnAnything = true;
+}
+
+}  // namespace requiem
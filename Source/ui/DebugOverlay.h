@@ -0,0 +1,114 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_UI_DEBUG_OVERLAY_H_
+#define REQUIEM_UI_DEBUG_OVERLAY_H_
+
+#include <array>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <axmol.h>
+
+// Debug drawing is compiled out of release builds unless explicitly enabled.
+#ifndef REQUIEM_ENABLE_DEBUG_OVERLAY
+#ifdef NDEBUG
+#define REQUIEM_ENABLE_DEBUG_OVERLAY 0
+#else
+#define REQUIEM_ENABLE_DEBUG_OVERLAY 1
+#endif
+#endif
+
+namespace requiem {
+
+// Immediate-mode debug drawing in game map coordinates (pixels).
+//
+// Everything drawn in a frame goes into one ax::DrawNode (and a fixed pool of
+// labels for text), which are cleared at the beginning of the next frame, so
+// the gameplay code never creates nodes or schedules callbacks to debug itself.
+// Each category is toggled separately from the console. When compiled out,
+// isEnabled() is always false and the draw calls are empty.
+class DebugOverlay final {
+ public:
+  enum class Category {
+    RAYCAST,
+    NAVIGATION,
+    SIZE
+  };
+
+  DebugOverlay();
+
+  // Clears whatever was drawn in the previous frame.
+  void beginFrame();
+
+  inline void drawLine(const Category category, const ax::Vec2& from, const ax::Vec2& to, const ax::Color4F& color) {
+#if REQUIEM_ENABLE_DEBUG_OVERLAY
+    if (isEnabled(category)) {
+      _drawNode->drawLine(from, to, color);
+      _hasDrawnAnything = true;
+    }
+#endif
+  }
+
+  inline void drawRect(const Category category, const ax::Vec2& origin, const ax::Vec2& dest, const ax::Color4F& color) {
+#if REQUIEM_ENABLE_DEBUG_OVERLAY
+    if (isEnabled(category)) {
+      _drawNode->drawRect(origin, dest, color);
+      _hasDrawnAnything = true;
+    }
+#endif
+  }
+
+  inline void drawPath(const Category category, std::span<const ax::Vec2> points, const ax::Color4F& color) {
+#if REQUIEM_ENABLE_DEBUG_OVERLAY
+    if (isEnabled(category) && points.size() >= 2) {
+      _drawNode->drawPoly(points.data(), static_cast<unsigned int>(points.size()), /*closedPolygon=*/false, color);
+      _hasDrawnAnything = true;
+    }
+#endif
+  }
+
+  inline void drawText(const Category category, const ax::Vec2& pos, std::string_view text, const ax::Color4F& color) {
+#if REQUIEM_ENABLE_DEBUG_OVERLAY
+    if (isEnabled(category)) {
+      doDrawText(pos, text, color);
+    }
+#endif
+  }
+
+  inline bool isEnabled(const Category category) const {
+#if REQUIEM_ENABLE_DEBUG_OVERLAY
+    return _isEnabled[static_cast<size_t>(category)];
+#else
+    return false;
+#endif
+  }
+
+  inline void setEnabled(const Category category, const bool enabled) {
+    _isEnabled[static_cast<size_t>(category)] = enabled;
+  }
+
+  inline ax::Layer* getLayer() const { return _layer; }
+
+  static const char* getCategoryName(const Category category);
+  static std::optional<Category> getCategoryByName(const std::string& name);
+
+  static inline constexpr bool kIsCompiledIn = REQUIEM_ENABLE_DEBUG_OVERLAY;
+  static inline constexpr int kMaxNumLabels = 32;
+
+ private:
+  void doDrawText(const ax::Vec2& pos, std::string_view text, const ax::Color4F& color);
+
+  ax::Layer* _layer;
+  ax::DrawNode* _drawNode;
+  std::vector<ax::Label*> _labels;
+  int _numUsedLabels{};
+  bool _hasDrawnAnything{};
+  std::array<bool, static_cast<size_t>(Category::SIZE)> _isEnabled{};
+};
+
+}  // namespace requiem
+
+#endif  // REQUIEM_UI_DEBUG_OVERLAY_H_
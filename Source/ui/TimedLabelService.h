@@ -33,6 +33,7 @@ class TimedLabelService {
 
   void update(const float delta);
   void show(const std::string& message);
+  inline bool isEmpty() const { return _labelQueue.empty(); }
   inline ax::Layer* getLayer() const { return _layer; }
 
  protected:
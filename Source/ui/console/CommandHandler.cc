@@ -3,8 +3,11 @@
 #include "CommandHandler.h"
 
 #include <memory>
+#include <optional>
 
 #include "Audio.h"
+#include "FrameClock.h"
+#include "TextureManager.h"
 #include "character/Player.h"
 #include "character/Npc.h"
 #include "gameplay/DialogueTree.h"
@@ -13,7 +16,9 @@
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
 #include "ui/Shade.h"
+#include "util/FrameArena.h"
 #include "util/JsonUtil.h"
+#include "util/RandUtil.h"
 #include "util/StringUtil.h"
 #include "util/Logger.h"
 
@@ -28,6 +33,15 @@ using CmdTable = unordered_map<string, void (CommandHandler::*)(const vector<str
 
 constexpr char kDefaultErrMsg[] = "Unable to parse this line";
 
+// Logs each line of a `xxxstats` report, and shows it as a notification.
+void showReport(const vector<string>& lines) {
+  auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
+  for (const auto& line : lines) {
+    VGLOG(LOG_INFO, "%s", line.c_str());
+    notifications->show(line);
+  }
+}
+
 }  // namespace
 
 bool CommandHandler::handle(const string& cmd, bool showNotification) {
@@ -76,6 +90,22 @@ bool CommandHandler::handle(const string& cmd, bool showNotification) {
     {cmd::kSetPos,             &CommandHandler::setPos             },
     {cmd::kRetainBodyIfKilled, &CommandHandler::retainBodyIfKilled },
     {cmd::kResurrect,          &CommandHandler::resurrect          },
+    {cmd::kTextureStats,       &CommandHandler::textureStats       },
+    {cmd::kSetTextureBudget,   &CommandHandler::setTextureBudget   },
+    {cmd::kDrawCalls,          &CommandHandler::drawCalls          },
+    {cmd::kFxStats,            &CommandHandler::fxStats            },
+    {cmd::kVolumeStats,        &CommandHandler::volumeStats        },
+    {cmd::kSetTimeScale,       &CommandHandler::setTimeScale       },
+    {cmd::kSeed,               &CommandHandler::seed               },
+    {cmd::kCheckpoint,         &CommandHandler::checkpoint         },
+    {cmd::kRestoreCheckpoint,  &CommandHandler::restoreCheckpoint  },
+    {cmd::kTickStats,          &CommandHandler::tickStats          },
+    {cmd::kArenaStats,         &CommandHandler::arenaStats         },
+    {cmd::kProjectileStats,    &CommandHandler::projectileStats    },
+    {cmd::kLightingStats,      &CommandHandler::lightingStats      },
+    {cmd::kDebugOverlay,       &CommandHandler::debugOverlay       },
+    {cmd::kStreamingStats,     &CommandHandler::streamingStats     },
+    {cmd::kPrefetchStats,      &CommandHandler::prefetchStats      },
   };
 
   // Execute the corresponding command handler from _cmdTable.
@@ -1397,4 +1427,227 @@ void CommandHandler::resurrect(const vector<string>& args) {
   setError(string_util::format("Failed to resurrect target [%s], not found", target.c_str()));
 }
 
+void CommandHandler::textureStats(const vector<string>& args) {
+  showReport(TextureManager::the().getReport());
+  setSuccess();
+}
+
+void CommandHandler::setTextureBudget(const vector<string>& args) {
+  if (args.size() < 2) {
+    setError(string_util::format("Usage: %s <budgetMiB>", args[0].c_str()));
+    return;
+  }
+
+  int budgetMiB{};
+  try {
+    budgetMiB = std::stoi(args[1]);
+  } catch (const invalid_argument& ex) {
+    setError(string_util::format("Invalid argument, budgetMiB: [%s]", args[1].c_str()));
+    return;
+  } catch (const out_of_range& ex) {
+    setError(string_util::format("Out of range, budgetMiB: [%s]", args[1].c_str()));
+    return;
+  } catch (...) {
+    setError("Unknown error");
+    return;
+  }
+
+  if (budgetMiB <= 0) {
+    setError("Texture budget must be greater than 0");
+    return;
+  }
+
+  TextureManager::the().setBudgetBytes(static_cast<size_t>(budgetMiB) * 1024 * 1024);
+  TextureManager::the().evictUntilWithinBudget();
+  setSuccess();
+}
+
+void CommandHandler::drawCalls(const vector<string>& args) {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  showReport(gmMgr->getSpriteBatchManager()->getReport());
+  setSuccess();
+}
+
+void CommandHandler::fxStats(const vector<string>& args) {
+  auto fxMgr = SceneManager::the().getCurrentScene<GameScene>()->getFxManager();
+  showReport(fxMgr->getPoolReport());
+  setSuccess();
+}
+
+void CommandHandler::volumeStats(const vector<string>& args) {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  showReport(gmMgr->getVolumeManager()->getReport());
+  setSuccess();
+}
+
+void CommandHandler::setTimeScale(const vector<string>& args) {
+  if (args.size() < 2) {
+    setError(string_util::format("Usage: %s <timeScale>", args[0].c_str()));
+    return;
+  }
+
+  float timeScale{};
+  try {
+    timeScale = std::stof(args[1]);
+  } catch (const invalid_argument& ex) {
+    setError(string_util::format("Invalid argument, timeScale: [%s]", args[1].c_str()));
+    return;
+  } catch (const out_of_range& ex) {
+    setError(string_util::format("Out of range, timeScale: [%s]", args[1].c_str()));
+    return;
+  } catch (...) {
+    setError("Unknown error");
+    return;
+  }
+
+  if (timeScale < 0 || timeScale > FrameClock::kMaxTimeScale) {
+    setError(string_util::format("Time scale must be within [0, %.1f]", FrameClock::kMaxTimeScale));
+    return;
+  }
+
+  FrameClock::the().setTimeScale(timeScale);
+  setSuccess();
+}
+
+void CommandHandler::seed(const vector<string>& args) {
+  if (args.size() > 3) {
+    setError(string_util::format("Usage: %s [stream] [seed]", args[0].c_str()));
+    return;
+  }
+
+  if (args.size() == 1) {
+    vector<string> lines;
+    for (int i = 0; i < static_cast<int>(rand_util::Stream::SIZE); i++) {
+      const auto stream = static_cast<rand_util::Stream>(i);
+      lines.push_back(string_util::format("%s: %llu", rand_util::getStreamName(stream),
+                                          static_cast<unsigned long long>(rand_util::getSeed(stream))));
+    }
+    showReport(lines);
+    setSuccess();
+    return;
+  }
+
+  optional<rand_util::Stream> stream;
+  if (args.size() == 3) {
+    stream = rand_util::getStreamByName(args[1]);
+    if (!stream) {
+      setError(string_util::format("Unknown stream: [%s]", args[1].c_str()));
+      return;
+    }
+  }
+
+  uint64_t seed{};
+  try {
+    seed = std::stoull(args.back());
+  } catch (const invalid_argument& ex) {
+    setError(string_util::format("Invalid argument, seed: [%s]", args.back().c_str()));
+    return;
+  } catch (const out_of_range& ex) {
+    setError(string_util::format("Out of range, seed: [%s]", args.back().c_str()));
+    return;
+  } catch (...) {
+    setError("Unknown error");
+    return;
+  }
+
+  if (stream) {
+    rand_util::setSeed(*stream, seed);
+  } else {
+    rand_util::setSeed(seed);
+  }
+  setSuccess();
+}
+
+void CommandHandler::checkpoint(const vector<string>& args) {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  gmMgr->getCheckpoint()->capture();
+  setSuccess();
+}
+
+void CommandHandler::restoreCheckpoint(const vector<string>& args) {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  if (!gmMgr->getCheckpoint()->restore()) {
+    setError("Failed to restore checkpoint");
+    return;
+  }
+  setSuccess();
+}
+
+void CommandHandler::tickStats(const vector<string>& args) {
+  auto tickRegistry = SceneManager::the().getCurrentScene<GameScene>()->getTickRegistry();
+  showReport(tickRegistry->getReport());
+  setSuccess();
+}
+
+void CommandHandler::arenaStats(const vector<string>& args) {
+  showReport(FrameArena::getReport());
+  setSuccess();
+}
+
+void CommandHandler::projectileStats(const vector<string>& args) {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  showReport(gmMgr->getProjectilePool()->getReport());
+  setSuccess();
+}
+
+void CommandHandler::lightingStats(const vector<string>& args) {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  showReport(gmMgr->getLighting()->getReport());
+  setSuccess();
+}
+
+void CommandHandler::debugOverlay(const vector<string>& args) {
+  if (!DebugOverlay::kIsCompiledIn) {
+    setError("The debug overlay is compiled out of this build");
+    return;
+  }
+
+  if (args.size() > 3 || (args.size() == 3 && args[2] != "on" && args[2] != "off")) {
+    setError(string_util::format("Usage: %s [category] [on|off]", args[0].c_str()));
+    return;
+  }
+
+  auto debugOverlay = SceneManager::the().getCurrentScene<GameScene>()->getDebugOverlay();
+  auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
+  if (args.size() == 1) {
+    vector<string> lines;
+    for (int i = 0; i < static_cast<int>(DebugOverlay::Category::SIZE); i++) {
+      const auto category = static_cast<DebugOverlay::Category>(i);
+      lines.push_back(string_util::format("%s: %s", DebugOverlay::getCategoryName(category),
+                                          debugOverlay->isEnabled(category) ? "on" : "off"));
+    }
+    showReport(lines);
+    setSuccess();
+    return;
+  }
+
+  const optional<DebugOverlay::Category> category = DebugOverlay::getCategoryByName(args[1]);
+  if (!category) {
+    setError(string_util::format("Unknown category: [%s]", args[1].c_str()));
+    return;
+  }
+
+  const bool enabled = args.size() == 3 ? args[2] == "on" : !debugOverlay->isEnabled(*category);
+  debugOverlay->setEnabled(*category, enabled);
+  notifications->show(string_util::format("Debug overlay [%s]: %s", args[1].c_str(), enabled ? "on" : "off"));
+  setSuccess();
+}
+
+void CommandHandler::streamingStats(const vector<string>& args) {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  if (!gmMgr->getGameMap()) {
+    setError("There's no game map");
+    return;
+  }
+
+  showReport(gmMgr->getGameMap()->getWorldStreamer().getReport());
+  setSuccess();
+}
+
+void CommandHandler::prefetchStats(const vector<string>& args) {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  showReport(gmMgr->getMapPrefetcher()->getReport());
+  setSuccess();
+}
+
 }  // namespace requiem
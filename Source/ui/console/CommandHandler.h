@@ -43,6 +43,22 @@ constexpr char kMoveToPos[] = "movetopos";
 constexpr char kSetPos[] = "setpos";
 constexpr char kRetainBodyIfKilled[] = "retainbodyifkilled";
 constexpr char kResurrect[] = "resurrect";
+constexpr char kTextureStats[] = "texturestats";
+constexpr char kSetTextureBudget[] = "settexturebudget";
+constexpr char kDrawCalls[] = "drawcalls";
+constexpr char kFxStats[] = "fxstats";
+constexpr char kVolumeStats[] = "volumestats";
+constexpr char kSetTimeScale[] = "settimescale";
+constexpr char kSeed[] = "seed";
+constexpr char kCheckpoint[] = "checkpoint";
+constexpr char kRestoreCheckpoint[] = "restorecheckpoint";
+constexpr char kTickStats[] = "tickstats";
+constexpr char kArenaStats[] = "arenastats";
+constexpr char kProjectileStats[] = "projectilestats";
+constexpr char kLightingStats[] = "lightingstats";
+constexpr char kDebugOverlay[] = "debugoverlay";
+constexpr char kStreamingStats[] = "streamingstats";
+constexpr char kPrefetchStats[] = "prefetchstats";
 
 }  // namespace cmd
 
@@ -88,6 +104,22 @@ class CommandHandler final {
   void setPos(const std::vector<std::string>& args);
   void retainBodyIfKilled(const std::vector<std::string>& args);
   void resurrect(const std::vector<std::string>& args);
+  void textureStats(const std::vector<std::string>& args);
+  void setTextureBudget(const std::vector<std::string>& args);
+  void drawCalls(const std::vector<std::string>& args);
+  void fxStats(const std::vector<std::string>& args);
+  void volumeStats(const std::vector<std::string>& args);
+  void setTimeScale(const std::vector<std::string>& args);
+  void seed(const std::vector<std::string>& args);
+  void checkpoint(const std::vector<std::string>& args);
+  void restoreCheckpoint(const std::vector<std::string>& args);
+  void tickStats(const std::vector<std::string>& args);
+  void arenaStats(const std::vector<std::string>& args);
+  void projectileStats(const std::vector<std::string>& args);
+  void lightingStats(const std::vector<std::string>& args);
+  void debugOverlay(const std::vector<std::string>& args);
+  void streamingStats(const std::vector<std::string>& args);
+  void prefetchStats(const std::vector<std::string>& args);
 
   bool _success{};
   std::string _errMsg;
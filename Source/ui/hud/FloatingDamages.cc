@@ -2,13 +2,16 @@
 
 #include "FloatingDamages.h"
 
+#include <algorithm>
+#include <string>
+
 #include "Assets.h"
 #include "Constants.h"
 #include "character/Character.h"
-#include "character/Player.h"
-#include "character/Npc.h"
+#include "character/Party.h"
+#include "scene/GameScene.h"
+#include "scene/SceneManager.h"
 #include "ui/Colorscheme.h"
-#include "util/AxUtil.h"
 
 using namespace std;
 using namespace requiem::assets;
@@ -16,74 +19,88 @@ USING_NS_AX;
 
 namespace requiem {
 
-FloatingDamages::FloatingDamages() : _layer{Layer::create()} {}
+namespace {
+
+// All the glyphs that a damage label may ever display.
+constexpr char kDamageGlyphs[] = "0123456789";
+
+}  // namespace
+
+FloatingDamages::FloatingDamages() : _layer{Layer::create()} {
+  for (auto& dmg : _damageLabels) {
+    // Creating the labels with every digit bakes these glyphs into
+    // the shared font atlas, so later setString() calls won't rasterize.
+    dmg.label = Label::createWithTTF(kDamageGlyphs, string{kRegularFont}, kRegularFontSize);
+    dmg.label->getFontAtlas()->setAliasTexParameters();
+    dmg.label->setVisible(false);
+    _layer->addChild(dmg.label);
+  }
+}
 
 void FloatingDamages::update(const float delta) {
-  deque<map<Character*, deque<DamageLabel>>::iterator> trash;
-
-  auto it = _damageMap.begin();
-  for (auto& characterDmgs : _damageMap) { // map<Character*, deque<FloatingDamage>>
-    for (auto& dmg : characterDmgs.second) { // FloatingDamage
-      dmg.timer += delta;
-
-      if (dmg.timer >= dmg.lifetime) {
-        dmg.label->runAction(Sequence::createWithTwoActions(
-          FadeOut::create(kFadeDuration),
-          CallFunc::create([this, dmg]() {
-            // After the label fully fades out, remove the label from _layer.
-            _layer->removeChild(dmg.label);
-          })
-        ));
-        // Also remove the FloatingDamage object from _damageMap.
-        auto& q = _damageMap[characterDmgs.first];
-        q.erase(std::remove(q.begin(), q.end(), dmg), q.end());
-
-        if (q.empty()) {
-          trash.push_back(it);
-        }
-      }
+  for (auto& dmg : _damageLabels) {
+    if (!dmg.isActive) {
+      continue;
     }
-    it++;
-  }
 
-  // Clean up unsued deques in _damageMap.
-  for (auto it : trash) {
-    _damageMap.erase(it);
+    dmg.timer += delta;
+    if (dmg.timer >= kLifetime + kFadeDuration) {
+      dmg.label->setVisible(false);
+      dmg.isActive = false;
+      dmg.character = nullptr;
+      _numActiveDamageLabels--;
+      continue;
+    }
+
+    // Move up the label until it reaches its slot in the stack.
+    const float targetOffsetY = (dmg.stackIdx + 1) * kDeltaY;
+    dmg.offsetY = std::min(dmg.offsetY + kDeltaY / kMoveUpDuration * delta, targetOffsetY);
+    dmg.label->setPosition(dmg.x + kDeltaX * (dmg.stackIdx + 1), dmg.y + dmg.offsetY);
+
+    if (dmg.timer >= kLifetime) {
+      const float remaining = 1.0f - (dmg.timer - kLifetime) / kFadeDuration;
+      dmg.label->setOpacity(static_cast<uint8_t>(255 * remaining));
+    }
   }
 }
 
 void FloatingDamages::show(Character* character, int damage) {
-  // If _damageMap does not have a deque of FloatingDamage objects for this character,
-  // then initialize it.
-  if (_damageMap.find(character) == _damageMap.end()) {
-    _damageMap[character] = {};
+  // Move up the previous floating damage labels owned by this character,
+  // and pick an idle label (or the oldest one if all of them are in use).
+  DamageLabel* newDmg = nullptr;
+  for (auto& dmg : _damageLabels) {
+    if (dmg.isActive && dmg.character == character) {
+      dmg.stackIdx++;
+    }
+    if (!newDmg || (newDmg->isActive && (!dmg.isActive || dmg.timer > newDmg->timer))) {
+      newDmg = &dmg;
+    }
   }
 
-  // Move up the previous floating damage labels owned by this character.
-  for (auto& floatingDamage : _damageMap[character]) {
-    floatingDamage.label->runAction(MoveBy::create(kMoveUpDuration, {kDeltaX, kDeltaY}));
-  }
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  const Character* player = gmMgr->getPlayer();
+  const shared_ptr<Party>& party = character->getParty();
+  const bool isPlayerSide = character == player || (party && party->getLeader() == player);
 
-  // Display the new floating damage label.
-  DamageLabel dmg(std::to_string(damage), 1.5f);
-  if (dynamic_cast<Player*>(character) ||
-      dynamic_cast<Npc*>(character)->isPlayerLeaderOfParty()) {
-    dmg.label->setTextColor(colorscheme::kRed);
+  if (!newDmg->isActive) {
+    _numActiveDamageLabels++;
   }
-  const auto& characterPos = character->getBody()->GetPosition();
-  float x = characterPos.x * kPpm;
-  float y = characterPos.y * kPpm + 15;
-  dmg.label->setPosition(x, y);
-  dmg.label->runAction(MoveBy::create(kMoveUpDuration, {kDeltaX, kDeltaY}));
 
-  _damageMap[character].push_back(dmg);
-  ax_util::addChildWithParentCameraMask(_layer, dmg.label);
-}
+  const auto& characterPos = character->getBody()->GetPosition();
+  newDmg->character = character;
+  newDmg->x = characterPos.x * kPpm;
+  newDmg->y = characterPos.y * kPpm + 15;
+  newDmg->offsetY = 0.0f;
+  newDmg->timer = 0.0f;
+  newDmg->stackIdx = 0;
+  newDmg->isActive = true;
 
-FloatingDamages::DamageLabel::DamageLabel(const string& text, const float lifetime)
-    : label{Label::createWithTTF(text, string{kRegularFont}, kRegularFontSize)},
-      lifetime{lifetime} {
-  label->getFontAtlas()->setAliasTexParameters();
+  // Display the new floating damage label.
+  newDmg->label->setString(std::to_string(damage));
+  newDmg->label->setTextColor(isPlayerSide ? colorscheme::kRed : colorscheme::kWhite);
+  newDmg->label->setOpacity(255);
+  newDmg->label->setPosition(newDmg->x, newDmg->y);
+  newDmg->label->setVisible(true);
 }
 
 }  // namespace requiem
@@ -3,9 +3,7 @@
 #ifndef REQUIEM_UI_HUD_FLOATING_DAMAGES_H_
 #define REQUIEM_UI_HUD_FLOATING_DAMAGES_H_
 
-#include <deque>
-#include <map>
-#include <string>
+#include <array>
 
 #include <axmol.h>
 
@@ -13,31 +11,42 @@ namespace requiem {
 
 class Character;
 
+// The damage labels are preallocated and recycled, and their glyphs
+// are baked into the font atlas upfront, so showing a damage number
+// neither allocates nor rasterizes anything.
 class FloatingDamages final {
  public:
   FloatingDamages();
 
   void update(const float delta);
   void show(Character* character, int damage);
+  inline bool hasActiveDamageLabels() const { return _numActiveDamageLabels > 0; }
   inline ax::Layer* getLayer() const { return _layer; }
 
  private:
-  struct DamageLabel {
-    DamageLabel(const std::string& text, const float lifetime);
-    bool operator==(const DamageLabel& other) { return label == other.label; }
-
-    ax::Label* label;
-    float lifetime;
+  struct DamageLabel final {
+    ax::Label* label{};
+    const Character* character{};
+    float x{};
+    float y{};
+    float offsetY{};
     float timer{};
+    // The number of newer damage labels of the same character,
+    // which determines how far this label is stacked up.
+    int stackIdx{};
+    bool isActive{};
   };
 
+  static inline constexpr int kMaxNumDamageLabels = 64;
   static inline constexpr float kDeltaX = 0.0f;
   static inline constexpr float kDeltaY = 10.0f;
   static inline constexpr float kMoveUpDuration = .2f;
   static inline constexpr float kFadeDuration = .2f;
+  static inline constexpr float kLifetime = 1.5f;
 
   ax::Layer* _layer;
-  std::map<Character*, std::deque<FloatingDamages::DamageLabel>> _damageMap;
+  std::array<DamageLabel, kMaxNumDamageLabels> _damageLabels;
+  int _numActiveDamageLabels{};
 };
 
 }  // namespace requiem
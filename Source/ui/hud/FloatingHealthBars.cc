@@ -0,0 +1,165 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#include "FloatingHealthBars.h"
+
+#include <algorithm>
+
+#include "Assets.h"
+#include "Constants.h"
+#include "character/Character.h"
+#include "scene/GameScene.h"
+#include "scene/SceneManager.h"
+
+using namespace std;
+using namespace requiem::assets;
+USING_NS_AX;
+
+namespace requiem {
+
+FloatingHealthBars::FloatingHealthBars() : _layer{Layer::create()} {
+  createAtlas();
+
+  _spriteBatchNode = SpriteBatchNode::createWithTexture(_atlas->getSprite()->getTexture(), kMaxNumHealthBars * 3);
+  _spriteBatchNode->getTexture()->setAliasTexParameters();
+  _layer->addChild(_spriteBatchNode);
+
+  for (auto& healthBar : _healthBars) {
+    healthBar.leftPaddingSprite = Sprite::createWithTexture(_spriteBatchNode->getTexture(), _leftPaddingRect);
+    healthBar.barSprite = Sprite::createWithTexture(_spriteBatchNode->getTexture(), _barRect);
+    healthBar.rightPaddingSprite = Sprite::createWithTexture(_spriteBatchNode->getTexture(), _rightPaddingRect);
+
+    for (auto sprite : {healthBar.leftPaddingSprite, healthBar.barSprite, healthBar.rightPaddingSprite}) {
+      // ax::RenderTexture's content is upside down.
+      sprite->setFlippedY(true);
+      sprite->setAnchorPoint({0, 0});
+      sprite->setVisible(false);
+      _spriteBatchNode->addChild(sprite);
+    }
+  }
+}
+
+void FloatingHealthBars::update(const float delta) {
+  const Camera* camera = SceneManager::the().getCurrentScene<GameScene>()->getGameCamera();
+  const Size& winSize = Director::getInstance()->getWinSize();
+  const Rect viewport{camera->getPosition() - Vec2{winSize.width / 2, winSize.height / 2}, winSize};
+
+  for (auto& healthBar : _healthBars) {
+    if (!healthBar.isActive) {
+      continue;
+    }
+
+    const auto& profile = healthBar.character->getCharacterProfile();
+    healthBar.timer += delta;
+    if (healthBar.timer >= kLifetime || profile.health >= profile.fullHealth) {
+      release(healthBar);
+      continue;
+    }
+
+    const auto& characterPos = healthBar.character->getBody()->GetPosition();
+    const float x = characterPos.x * kPpm - kLength / 2;
+    const float y = characterPos.y * kPpm + profile.bodyHeight / 2 + kOffsetY;
+    const Rect rect{x, y, kLength + _leftPaddingRect.size.width + _rightPaddingRect.size.width, _barRect.size.height};
+    if (!viewport.intersectsRect(rect)) {
+      setVisible(healthBar, false);
+      continue;
+    }
+
+    if (healthBar.health != profile.health) {
+      healthBar.health = profile.health;
+      healthBar.length = kLength * std::max(profile.health, 0) / profile.fullHealth;
+      healthBar.barSprite->setScaleX(healthBar.length / _barRect.size.width);
+    }
+
+    healthBar.leftPaddingSprite->setPosition(x, y);
+    healthBar.barSprite->setPosition(x + _leftPaddingRect.size.width, y);
+    healthBar.rightPaddingSprite->setPosition(x + _leftPaddingRect.size.width + healthBar.length, y);
+    setVisible(healthBar, true);
+  }
+}
+
+void FloatingHealthBars::show(const Character* character) {
+  // Reuse the bar of this character if it has one, otherwise pick an idle bar
+  // (or the oldest one if all of them are in use).
+  HealthBar* newHealthBar = nullptr;
+  for (auto& healthBar : _healthBars) {
+    if (healthBar.isActive && healthBar.character == character) {
+      newHealthBar = &healthBar;
+      break;
+    }
+    if (!newHealthBar || (newHealthBar->isActive && (!healthBar.isActive || healthBar.timer > newHealthBar->timer))) {
+      newHealthBar = &healthBar;
+    }
+  }
+
+  if (!newHealthBar->isActive) {
+    _numActiveHealthBars++;
+  } else if (newHealthBar->character != character) {
+    newHealthBar->health = -1;
+  }
+
+  newHealthBar->character = character;
+  newHealthBar->timer = 0.0f;
+  newHealthBar->isActive = true;
+}
+
+void FloatingHealthBars::hide(const Character* character) {
+  for (auto& healthBar : _healthBars) {
+    if (healthBar.isActive && healthBar.character == character) {
+      release(healthBar);
+      return;
+    }
+  }
+}
+
+void FloatingHealthBars::createAtlas() {
+  Sprite* leftPaddingSprite = Sprite::create(kBarLeftPadding.native());
+  Sprite* barSprite = Sprite::create(kHealthBar.native());
+  Sprite* rightPaddingSprite = Sprite::create(kBarRightPadding.native());
+
+  // Pack the images side by side, aligned to the bottom of the atlas.
+  float width = 0;
+  float height = 0;
+  for (auto sprite : {leftPaddingSprite, barSprite, rightPaddingSprite}) {
+    width += sprite->getContentSize().width;
+    height = std::max(height, sprite->getContentSize().height);
+  }
+
+  _atlas = RenderTexture::create(width, height, backend::PixelFormat::RGBA8);
+  _atlas->retain();
+  _atlas->beginWithClear(0, 0, 0, 0);
+
+  float x = 0;
+  for (auto [sprite, rect] : {pair{leftPaddingSprite, &_leftPaddingRect},
+                              pair{barSprite, &_barRect},
+                              pair{rightPaddingSprite, &_rightPaddingRect}}) {
+    const Size& size = sprite->getContentSize();
+    sprite->setAnchorPoint({0, 0});
+    sprite->setPosition(x, 0);
+    sprite->setBlendFunc(BlendFunc::DISABLE);
+    sprite->visit();
+
+    // ax::RenderTexture stores its rows bottom-up, so the bottom-aligned images
+    // start at the top of the texture (hence the sprites being flipped).
+    rect->setRect(x, 0, size.width, size.height);
+    x += size.width;
+  }
+
+  _atlas->end();
+}
+
+void FloatingHealthBars::release(HealthBar& healthBar) {
+  setVisible(healthBar, false);
+  healthBar.character = nullptr;
+  healthBar.health = -1;
+  healthBar.length = 0;
+  healthBar.isActive = false;
+  _numActiveHealthBars--;
+}
+
+void FloatingHealthBars::setVisible(HealthBar& healthBar, const bool visible) const {
+  healthBar.leftPaddingSprite->setVisible(visible);
+  healthBar.barSprite->setVisible(visible);
+  healthBar.rightPaddingSprite->setVisible(visible);
+}
+
+}  // namespace requiem
@@ -0,0 +1,67 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_UI_HUD_FLOATING_HEALTH_BARS_H_
+#define REQUIEM_UI_HUD_FLOATING_HEALTH_BARS_H_
+
+#include <array>
+
+#include <axmol.h>
+
+namespace requiem {
+
+class Character;
+
+// The health bars floating above the damaged npcs.
+//
+// The bar images are packed into a single atlas upfront, and all the bars
+// are preallocated as sprites of one ax::SpriteBatchNode, so drawing every
+// health bar on screen costs a single draw call. A bar is only resized when
+// its character's health has changed, and it is hidden while its character
+// is off screen or at full health.
+class FloatingHealthBars final {
+ public:
+  FloatingHealthBars();
+  ~FloatingHealthBars() { AX_SAFE_RELEASE(_atlas); }
+  FloatingHealthBars(const FloatingHealthBars&) = delete;
+  FloatingHealthBars& operator=(const FloatingHealthBars&) = delete;
+
+  void update(const float delta);
+  void show(const Character* character);
+  void hide(const Character* character);
+  inline bool hasActiveHealthBars() const { return _numActiveHealthBars > 0; }
+  inline ax::Layer* getLayer() const { return _layer; }
+
+ private:
+  struct HealthBar final {
+    ax::Sprite* leftPaddingSprite{};
+    ax::Sprite* barSprite{};
+    ax::Sprite* rightPaddingSprite{};
+    const Character* character{};
+    int health{-1};
+    float length{};
+    float timer{};
+    bool isActive{};
+  };
+
+  void createAtlas();
+  void release(HealthBar& healthBar);
+  void setVisible(HealthBar& healthBar, const bool visible) const;
+
+  static inline constexpr int kMaxNumHealthBars = 32;
+  static inline constexpr float kLength = 45.0f;
+  static inline constexpr float kOffsetY = 10.0f;
+  static inline constexpr float kLifetime = 5.0f;
+
+  ax::Layer* _layer;
+  ax::RenderTexture* _atlas{};
+  ax::SpriteBatchNode* _spriteBatchNode{};
+  ax::Rect _leftPaddingRect;
+  ax::Rect _barRect;
+  ax::Rect _rightPaddingRect;
+  std::array<HealthBar, kMaxNumHealthBars> _healthBars;
+  int _numActiveHealthBars{};
+};
+
+}  // namespace requiem
+
+#endif  // REQUIEM_UI_HUD_FLOATING_HEALTH_BARS_H_
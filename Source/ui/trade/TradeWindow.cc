@@ -28,7 +28,7 @@ TradeWindow::TradeWindow(Character* buyer, Character* seller)
       _contentBackground{ui::ImageView::create(string{kTradeBg})},
       _tabView{std::make_unique<TabView>(kTabRegular, kTabHighlighted)},
       _tradeListView{std::make_unique<TradeListView>(this)},
-      _isTradingWithAlly{seller->getAllies().find(buyer) != seller->getAllies().end()},
+      _isTradingWithAlly{seller->isAlly(buyer)},
       _buyer{buyer},
       _seller{seller} {
   // Resize window: Make the window slightly larger than `_contentBackground`.
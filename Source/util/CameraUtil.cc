@@ -78,8 +78,8 @@ void updateShake(Camera* camera, const float delta) {
 
   if (currentTime <= duration) {
     currentPower = power * ((duration - currentTime) / duration);
-    pos.x = (rand_util::randFloat() - 0.5f) * 2 * currentPower; // camera offset X
-    pos.y = (rand_util::randFloat() - 0.5f) * 2 * currentPower; // camera offset Y
+    pos.x = (rand_util::randFloat(rand_util::Stream::FX) - 0.5f) * 2 * currentPower; // camera offset X
+    pos.y = (rand_util::randFloat(rand_util::Stream::FX) - 0.5f) * 2 * currentPower; // camera offset Y
     currentTime += delta;
     // Translate camera
     const Vec2& camPos = camera->getPosition();
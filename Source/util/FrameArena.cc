@@ -0,0 +1,99 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "util/StringUtil.h"
+
+using namespace std;
+
+namespace requiem {
+
+namespace {
+
+// All the arenas which have been created by the threads so far.
+mutex arenasMutex;
+vector<FrameArena*> arenas;
+
+inline float toKiB(const size_t bytes) {
+  return bytes / 1024.0f;
+}
+
+}  // namespace
+
+FrameArena::FrameArena()
+    : _buffer{make_unique<byte[]>(kInitialCapacity)},
+      _capacity{kInitialCapacity} {
+  lock_guard<mutex> lock{arenasMutex};
+  arenas.push_back(this);
+}
+
+FrameArena::~FrameArena() {
+  lock_guard<mutex> lock{arenasMutex};
+  arenas.erase(std::remove(arenas.begin(), arenas.end(), this), arenas.end());
+}
+
+FrameArena& FrameArena::the() {
+  static thread_local FrameArena instance;
+  return instance;
+}
+
+void FrameArena::resetAll() {
+  lock_guard<mutex> lock{arenasMutex};
+  for (auto arena : arenas) {
+    arena->reset();
+  }
+}
+
+vector<string> FrameArena::getReport() {
+  lock_guard<mutex> lock{arenasMutex};
+
+  vector<string> report;
+  for (size_t i = 0; i < arenas.size(); i++) {
+    const FrameArena* arena = arenas[i];
+    report.push_back(string_util::format("arena #%d: %.1f/%.1f KiB, peak %.1f KiB, %d overflow(s)",
+                                         static_cast<int>(i),
+                                         toKiB(arena->_offset + arena->_numOverflowBytes),
+                                         toKiB(arena->_capacity),
+                                         toKiB(arena->_peakNumBytes),
+                                         static_cast<int>(arena->_numOverflows)));
+  }
+  return report;
+}
+
+void* FrameArena::allocate(const size_t numBytes, const size_t alignment) {
+  const size_t alignedOffset = (_offset + alignment - 1) & ~(alignment - 1);
+  if (alignedOffset + numBytes <= _capacity) {
+    _offset = alignedOffset + numBytes;
+    _peakNumBytes = std::max(_peakNumBytes, _offset + _numOverflowBytes);
+    return _buffer.get() + alignedOffset;
+  }
+
+  // operator new[] returns memory suitably aligned for any fundamental type.
+  _overflowBlocks.push_back(make_unique<byte[]>(numBytes));
+  _numOverflowBytes += numBytes;
+  _numOverflows++;
+  _peakNumBytes = std::max(_peakNumBytes, _offset + _numOverflowBytes);
+  return _overflowBlocks.back().get();
+}
+
+void FrameArena::reset() {
+#ifndef NDEBUG
+  std::memset(_buffer.get(), kPoisonByte, _offset);
+#endif
+
+  // Grow the buffer so that a frame as large as the peak fits into it.
+  if (_peakNumBytes > _capacity) {
+    _capacity = std::max(_capacity * 2, _peakNumBytes);
+    _buffer = make_unique<byte[]>(_capacity);
+  }
+
+  _offset = 0;
+  _overflowBlocks.clear();
+  _numOverflowBytes = 0;
+}
+
+}  // namespace requiem
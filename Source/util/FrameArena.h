@@ -0,0 +1,96 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_UTIL_FRAME_ARENA_H_
+#define REQUIEM_UTIL_FRAME_ARENA_H_
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace requiem {
+
+// A bump allocator for the data which only lives within a frame. Each thread
+// (the main thread and the AI workers) allocates from its own arena, and all of
+// them are rewound at once at the top of GameScene::update(), so nothing allocated
+// from an arena may outlive the frame.
+//
+// If a frame needs more than the current capacity, the overflow is served from the
+// heap and the arena grows to the peak usage upon the next reset, so that in steady
+// state no heap allocation happens at all. In debug builds, the memory released by
+// a reset is poisoned to catch the dangling references.
+class FrameArena final {
+ public:
+  FrameArena();
+  FrameArena(const FrameArena&) = delete;
+  FrameArena& operator=(const FrameArena&) = delete;
+  ~FrameArena();
+
+  // @return: the arena of the calling thread.
+  static FrameArena& the();
+
+  // Rewinds the arenas of all threads.
+  // This must only be called while none of the other threads are running jobs.
+  static void resetAll();
+
+  static std::vector<std::string> getReport();
+
+  void* allocate(const size_t numBytes, const size_t alignment);
+
+  static inline constexpr size_t kInitialCapacity = 64 * 1024;
+  static inline constexpr unsigned char kPoisonByte = 0xdd;
+
+ private:
+  void reset();
+
+  std::unique_ptr<std::byte[]> _buffer;
+  size_t _capacity{};
+  size_t _offset{};
+  // The heap blocks which served the allocations that didn't fit into `_buffer`.
+  std::vector<std::unique_ptr<std::byte[]>> _overflowBlocks;
+  size_t _numOverflowBytes{};
+  size_t _peakNumBytes{};
+  size_t _numOverflows{};
+};
+
+// An STL allocator which allocates from the calling thread's FrameArena.
+// Deallocation is a no-op, since the memory is reclaimed as a whole at the end of the frame.
+template <typename T>
+class FrameAllocator final {
+ public:
+  using value_type = T;
+
+  FrameAllocator() noexcept = default;
+  template <typename U>
+  FrameAllocator(const FrameAllocator<U>&) noexcept {}
+
+  T* allocate(const size_t n) {
+    return static_cast<T*>(FrameArena::the().allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T*, const size_t) noexcept {}
+
+  template <typename U>
+  bool operator==(const FrameAllocator<U>&) const noexcept { return true; }
+  template <typename U>
+  bool operator!=(const FrameAllocator<U>&) const noexcept { return false; }
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+template <typename T>
+using FrameList = std::list<T, FrameAllocator<T>>;
+
+template <typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>>
+using FrameUnorderedSet = std::unordered_set<T, Hash, KeyEqual, FrameAllocator<T>>;
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+using FrameUnorderedMap = std::unordered_map<K, V, Hash, KeyEqual, FrameAllocator<std::pair<const K, V>>>;
+
+}  // namespace requiem
+
+#endif  // REQUIEM_UTIL_FRAME_ARENA_H_
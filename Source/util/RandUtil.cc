@@ -2,21 +2,116 @@
 
 #include "RandUtil.h"
 
+#include <array>
 #include <ctime>
-#include <random>
+
+using namespace std;
 
 namespace requiem::rand_util {
 
+namespace {
+
+constexpr array<const char*, static_cast<size_t>(Stream::SIZE)> kStreamNames{{
+  "loot",
+  "ai",
+  "fx",
+  "combat",
+}};
+
+inline uint64_t rotl(const uint64_t x, const int k) {
+  return (x << k) | (x >> (64 - k));
+}
+
+// Used to expand a single 64-bit seed into xoshiro's 256-bit state,
+// as recommended by its authors.
+inline uint64_t splitMix64(uint64_t& x) {
+  uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+class Xoshiro256 final {
+ public:
+  void seed(const uint64_t seed) {
+    _seed = seed;
+    uint64_t x = seed;
+    for (auto& s : _state) {
+      s = splitMix64(x);
+    }
+  }
+
+  uint64_t next() {
+    const uint64_t result = rotl(_state[1] * 5, 7) * 9;
+    const uint64_t t = _state[1] << 17;
+    _state[2] ^= _state[0];
+    _state[3] ^= _state[1];
+    _state[1] ^= _state[2];
+    _state[0] ^= _state[3];
+    _state[2] ^= t;
+    _state[3] = rotl(_state[3], 45);
+    return result;
+  }
+
+  inline uint64_t getSeed() const { return _seed; }
+
+ private:
+  array<uint64_t, 4> _state{};
+  uint64_t _seed{};
+};
+
+array<Xoshiro256, static_cast<size_t>(Stream::SIZE)> streams;
+
+inline Xoshiro256& getStream(const Stream stream) {
+  return streams[static_cast<size_t>(stream)];
+}
+
+}  // namespace
+
 void init() {
-  srand(static_cast<unsigned int>(time(nullptr)));
+  setSeed(static_cast<uint64_t>(time(nullptr)));
+}
+
+void setSeed(const uint64_t seed) {
+  uint64_t x = seed;
+  for (auto& stream : streams) {
+    stream.seed(splitMix64(x));
+  }
+}
+
+void setSeed(const Stream stream, const uint64_t seed) {
+  getStream(stream).seed(seed);
+}
+
+uint64_t getSeed(const Stream stream) {
+  return getStream(stream).getSeed();
+}
+
+const char* getStreamName(const Stream stream) {
+  return kStreamNames[static_cast<size_t>(stream)];
+}
+
+optional<Stream> getStreamByName(const string& name) {
+  for (size_t i = 0; i < kStreamNames.size(); i++) {
+    if (name == kStreamNames[i]) {
+      return static_cast<Stream>(i);
+    }
+  }
+  return nullopt;
 }
 
-int randInt(int min, int max) {
-  return (rand() % (max + 1 - min)) + min;
+int randInt(const Stream stream, int min, int max) {
+  // Maps the upper 32 bits onto [0, range) with a multiply-shift rather than
+  // a modulo, which is both faster and less biased.
+  const uint64_t range = static_cast<uint64_t>(max) + 1 - min;
+  const uint64_t r = getStream(stream).next() >> 32;
+  return min + static_cast<int>((r * range) >> 32);
 }
 
-float randFloat(float min, float max) {
-  return (float(rand()) / (float(RAND_MAX) + 1.0)) * (max - min) + min;
+float randFloat(const Stream stream, float min, float max) {
+  // The upper 24 bits fill the mantissa of a float in [0, 1).
+  const float r = (getStream(stream).next() >> 40) * 0x1.0p-24f;
+  return r * (max - min) + min;
 }
 
 }  // namespace requiem::rand_util
@@ -3,11 +3,38 @@
 #ifndef REQUIEM_UTIL_RAND_UTIL_H_
 #define REQUIEM_UTIL_RAND_UTIL_H_
 
+#include <cstdint>
+#include <optional>
+#include <string>
+
 namespace requiem::rand_util {
 
+// Each subsystem draws from its own xoshiro256** stream, so that reseeding
+// (or adding draws to) one subsystem doesn't perturb the others, and a run
+// can be reproduced by restoring the seeds.
+//
+// The streams are not synchronized and must only be used on the main thread.
+enum class Stream {
+  LOOT,
+  AI,
+  FX,
+  COMBAT,
+  SIZE
+};
+
+// Seeds all streams from the current time.
 void init();
-int randInt(int min=0, int max=1);
-float randFloat(float min=0.0f, float max=1.0f);
+
+// Derives the seeds of all streams from `seed`.
+void setSeed(const uint64_t seed);
+void setSeed(const Stream stream, const uint64_t seed);
+uint64_t getSeed(const Stream stream);
+
+const char* getStreamName(const Stream stream);
+std::optional<Stream> getStreamByName(const std::string& name);
+
+int randInt(const Stream stream, int min=0, int max=1);
+float randFloat(const Stream stream, float min=0.0f, float max=1.0f);
 
 }  // namespace requiem::rand_util
 
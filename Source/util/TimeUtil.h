@@ -1,14 +0,0 @@
-// Copyright (c) 2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
-
-#ifndef REQUIEM_UTIL_TIME_UTIL_H_
-#define REQUIEM_UTIL_TIME_UTIL_H_
-
-#include <cstdint>
-
-namespace requiem::time_util {
-
-uint64_t getCurrentTimeMs();
-
-}  // namespace requiem::time_util
-
-#endif  // REQUIEM_UTIL_TIME_UTIL_H_
@@ -0,0 +1,90 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#include "WorkerPool.h"
+
+using namespace std;
+
+namespace requiem {
+
+WorkerPool::WorkerPool(const int numWorkers) {
+  _workers.reserve(numWorkers);
+  for (int i = 0; i < numWorkers; i++) {
+    _workers.emplace_back(&WorkerPool::runWorker, this);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    lock_guard<mutex> lock{_mutex};
+    _isTerminating = true;
+  }
+  _jobsAvailableCv.notify_all();
+
+  for (auto& worker : _workers) {
+    worker.join();
+  }
+}
+
+void WorkerPool::parallelFor(const int numJobs, const function<void (const int)>& job) {
+  if (numJobs <= 0) {
+    return;
+  }
+
+  if (_workers.empty() || numJobs == 1) {
+    for (int i = 0; i < numJobs; i++) {
+      job(i);
+    }
+    return;
+  }
+
+  {
+    lock_guard<mutex> lock{_mutex};
+    _job = &job;
+    _numJobs = numJobs;
+    _nextJobIdx = 0;
+    _numPendingWorkers = static_cast<int>(_workers.size());
+    _batchSeq++;
+  }
+  _jobsAvailableCv.notify_all();
+
+  runJobs();
+
+  // Every worker has to check in for each batch, so that no worker
+  // can still be holding onto `job` after this function returns.
+  unique_lock<mutex> lock{_mutex};
+  _jobsDoneCv.wait(lock, [this]() { return _numPendingWorkers == 0; });
+  _job = nullptr;
+}
+
+void WorkerPool::runWorker() {
+  uint64_t lastBatchSeq = 0;
+
+  while (true) {
+    {
+      unique_lock<mutex> lock{_mutex};
+      _jobsAvailableCv.wait(lock, [this, lastBatchSeq]() {
+        return _isTerminating || _batchSeq != lastBatchSeq;
+      });
+      if (_isTerminating) {
+        return;
+      }
+      lastBatchSeq = _batchSeq;
+    }
+
+    runJobs();
+
+    {
+      lock_guard<mutex> lock{_mutex};
+      _numPendingWorkers--;
+    }
+    _jobsDoneCv.notify_one();
+  }
+}
+
+void WorkerPool::runJobs() {
+  for (int i = _nextJobIdx.fetch_add(1); i < _numJobs; i = _nextJobIdx.fetch_add(1)) {
+    (*_job)(i);
+  }
+}
+
+}  // namespace requiem
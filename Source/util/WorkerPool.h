@@ -0,0 +1,49 @@
+// Copyright (c) 2018-2025 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+
+#ifndef REQUIEM_UTIL_WORKER_POOL_H_
+#define REQUIEM_UTIL_WORKER_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace requiem {
+
+// A fixed number of worker threads which are created once and reused.
+class WorkerPool final {
+ public:
+  explicit WorkerPool(const int numWorkers);
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+  ~WorkerPool();
+
+  // Runs job(i) for every i in [0, numJobs) on the workers and the calling thread,
+  // and returns only after all of them have finished.
+  void parallelFor(const int numJobs, const std::function<void (const int jobIdx)>& job);
+
+  inline int getNumWorkers() const { return static_cast<int>(_workers.size()); }
+
+ private:
+  void runWorker();
+  void runJobs();
+
+  std::vector<std::thread> _workers;
+  std::mutex _mutex;
+  std::condition_variable _jobsAvailableCv;
+  std::condition_variable _jobsDoneCv;
+  const std::function<void (const int)>* _job{};
+  int _numJobs{};
+  std::atomic<int> _nextJobIdx{};
+  // The number of workers which haven't finished the current batch of jobs yet.
+  int _numPendingWorkers{};
+  uint64_t _batchSeq{};
+  bool _isTerminating{};
+};
+
+}  // namespace requiem
+
+#endif  // REQUIEM_UTIL_WORKER_POOL_H_